@@ -469,6 +469,7 @@ void AchievementMgr::Reset()
 
     m_completedAchievements.clear();
     m_criteriaProgress.clear();
+    m_completedCriteria.clear();
     DeleteFromDB(m_player->GetObjectGuid());
 
     // re-fill data
@@ -702,6 +703,8 @@ void AchievementMgr::LoadFromDB(std::unique_ptr<QueryResult> achievementResult,
                     progress.changed = true;
                 }
             }
+
+            UpdateCompletedCriteria(criteria, achievement);
         }
         while (criteriaResult->NextRow());
     }
@@ -914,7 +917,10 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
     if (!sWorld.getConfig(CONFIG_BOOL_GM_ALLOW_ACHIEVEMENT_GAINS) && m_player->GetSession()->GetSecurity() > SEC_PLAYER)
         return;
 
-    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr.GetAchievementCriteriaByType(type);
+    // events with an asset only need the criteria of that asset, without one (login checks) all criteria of the type are checked
+    AchievementCriteriaEntryList const& achievementCriteriaList = miscvalue1 && AchievementGlobalMgr::IsCriteriaTypeIndexedByAsset(type)
+            ? sAchievementMgr.GetAchievementCriteriaByTypeAndAsset(type, miscvalue1)
+            : sAchievementMgr.GetAchievementCriteriaByType(type);
     for (auto achievementCriteria : achievementCriteriaList)
     {
         AchievementEntry const* achievement = sAchievementStore.LookupEntry(achievementCriteria->referredAchievement);
@@ -2095,6 +2101,9 @@ uint32 AchievementMgr::GetCriteriaProgressMaxCounter(AchievementCriteriaEntry co
 
 bool AchievementMgr::IsCompletedCriteria(AchievementCriteriaEntry const* achievementCriteria, AchievementEntry const* achievement) const
 {
+    if (achievementCriteria->ID < m_completedCriteria.size() && m_completedCriteria[achievementCriteria->ID])
+        return true;
+
     // counter can never complete
     if (achievement->flags & ACHIEVEMENT_FLAG_COUNTER)
         return false;
@@ -2117,6 +2126,19 @@ bool AchievementMgr::IsCompletedCriteria(AchievementCriteriaEntry const* achieve
     return progress->counter >= maxcounter || (achievement->flags & ACHIEVEMENT_FLAG_REQ_COUNT && progress->counter);
 }
 
+void AchievementMgr::UpdateCompletedCriteria(AchievementCriteriaEntry const* criteria, AchievementEntry const* achievement)
+{
+    // completion of counters and realm firsts doesn't only depend on the progress
+    if (achievement->flags & (ACHIEVEMENT_FLAG_COUNTER | ACHIEVEMENT_FLAG_REALM_FIRST_REACH | ACHIEVEMENT_FLAG_REALM_FIRST_KILL))
+        return;
+
+    if (criteria->ID >= m_completedCriteria.size())
+        m_completedCriteria.resize(sAchievementCriteriaStore.GetNumRows(), false);
+
+    m_completedCriteria[criteria->ID] = false;
+    m_completedCriteria[criteria->ID] = IsCompletedCriteria(criteria, achievement);
+}
+
 void AchievementMgr::CompletedCriteriaFor(AchievementEntry const* achievement)
 {
     // counter can never complete
@@ -2256,6 +2278,8 @@ void AchievementMgr::SetCriteriaProgress(AchievementCriteriaEntry const* criteri
     progress->counter = newValue;
     progress->changed = true;
 
+    UpdateCompletedCriteria(criteria, achievement);
+
     // update client side value
     SendCriteriaUpdate(criteria->ID, progress);
 
@@ -2457,6 +2481,51 @@ AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteria
     return m_AchievementCriteriasByType[type];
 }
 
+AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteriaByTypeAndAsset(AchievementCriteriaTypes type, uint32 asset) const
+{
+    static AchievementCriteriaEntryList const emptyList;
+
+    auto itr = m_AchievementCriteriasByTypeAndAsset[type].find(asset);
+    return itr != m_AchievementCriteriasByTypeAndAsset[type].end() ? itr->second : emptyList;
+}
+
+// types whose criteria are only updated by events of their asset (raw.value) when the event has one (miscvalue1 != 0)
+bool AchievementGlobalMgr::IsCriteriaTypeIndexedByAsset(AchievementCriteriaTypes type)
+{
+    switch (type)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_TEAM_RATING:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_PERSONAL_RATING:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+            return true;
+        default:
+            return false;
+    }
+}
+
 AchievementCriteriaEntryList const* AchievementGlobalMgr::GetAchievementCriteriaByAchievement(uint32 id)
 {
     AchievementCriteriaListByAchievement::const_iterator itr = m_AchievementCriteriaListByAchievement.find(id);
@@ -2539,6 +2608,8 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
         }
 
         m_AchievementCriteriasByType[criteria->requiredType].push_back(criteria);
+        if (IsCriteriaTypeIndexedByAsset(AchievementCriteriaTypes(criteria->requiredType)))
+            m_AchievementCriteriasByTypeAndAsset[criteria->requiredType][criteria->raw.value].push_back(criteria);
         m_AchievementCriteriaListByAchievement[criteria->referredAchievement].push_back(criteria);
         ++count;
     }
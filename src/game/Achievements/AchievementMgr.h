@@ -318,10 +318,12 @@ class AchievementMgr
         void CompletedAchievement(AchievementEntry const* achievement);
         void IncompletedAchievement(AchievementEntry const* achievement);
         bool IsCompletedAchievement(AchievementEntry const* entry);
+        void UpdateCompletedCriteria(AchievementCriteriaEntry const* criteria, AchievementEntry const* achievement);
         void BuildAllDataPacket(WorldPacket& data);
 
         Player* m_player;
         CriteriaProgressMap m_criteriaProgress;
+        std::vector<bool> m_completedCriteria;              // by criteria id, criteria whose progress can't change anymore
         CompletedAchievementMap m_completedAchievements;
         AchievementCriteriaFailTimeMap m_criteriaFailTimes;
 };
@@ -330,6 +332,9 @@ class AchievementGlobalMgr
 {
     public:
         AchievementCriteriaEntryList const& GetAchievementCriteriaByType(AchievementCriteriaTypes type) const;
+        // criteria of the type with the given asset (creature, spell, item, ...), only for types of IsCriteriaTypeIndexedByAsset
+        AchievementCriteriaEntryList const& GetAchievementCriteriaByTypeAndAsset(AchievementCriteriaTypes type, uint32 asset) const;
+        static bool IsCriteriaTypeIndexedByAsset(AchievementCriteriaTypes type);
         AchievementCriteriaEntryList const* GetAchievementCriteriaByAchievement(uint32 id);
         AchievementEntryList const* GetAchievementByReferencedId(uint32 id) const;
         AchievementReward const* GetAchievementReward(AchievementEntry const* achievement, uint8 gender) const;
@@ -351,6 +356,8 @@ class AchievementGlobalMgr
 
         // store achievement criterias by type to speed up lookup
         AchievementCriteriaEntryList m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        // store achievement criterias by type and asset for types only updating criteria of the event's asset
+        std::unordered_map<uint32, AchievementCriteriaEntryList> m_AchievementCriteriasByTypeAndAsset[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
         // store achievement criterias by achievement to speed up lookup
         AchievementCriteriaListByAchievement m_AchievementCriteriaListByAchievement;
         // store achievements by referenced achievement id to speed up lookup
@@ -29,6 +29,10 @@
 #include "Util/Util.h"
 #include "Chat/Chat.h"
 
+#ifdef BUILD_METRICS
+ #include "Metric/Metric.h"
+#endif
+
 // please DO NOT use iterator++, because it is slower than ++iterator!!!
 // post-incrementation is always slower than pre-incrementation !
 
@@ -639,14 +643,36 @@ void WorldSession::HandleAuctionListItems(WorldPacket& recv_data)
     // always return pointer
     AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(auctionHouseEntry);
 
-    // Sort
-    AuctionHouseObject::AuctionEntryMap const& aucs = auctionHouse->GetAuctions();
+    auto searchStart = std::chrono::steady_clock::now();
+
+    // converting string that we try to find to lower case
+    AuctionSearchFilter filter;
+    if (!Utf8toWStr(searchedname, filter.searchedName))
+        return;
+
+    wstrToLower(filter.searchedName);
+    filter.localeIndex = GetSessionDbLocaleIndex();
+    filter.levelMin = levelmin;
+    filter.levelMax = levelmax;
+    filter.inventoryType = auctionSlotID;
+    filter.itemClass = auctionMainCategory;
+    filter.itemSubClass = auctionSubCategory;
+    filter.quality = quality;
+
+    // full scans return everything, the indexes only narrow down filtered searches
     std::vector<AuctionEntry*> auctions;
-    auctions.reserve(aucs.size());
+    if (isFull)
+    {
+        AuctionHouseObject::AuctionEntryMap const& aucs = auctionHouse->GetAuctions();
+        auctions.reserve(aucs.size());
 
-    for (const auto& auc : aucs)
-        auctions.push_back(auc.second);
+        for (const auto& auc : aucs)
+            auctions.push_back(auc.second);
+    }
+    else
+        auctionHouse->FindAuctions(filter, auctions);
 
+    // Sort
     AuctionSorter sorter(Sort, GetPlayer());
     std::sort(auctions.begin(), auctions.end(), sorter);
 
@@ -658,16 +684,18 @@ void WorldSession::HandleAuctionListItems(WorldPacket& recv_data)
     uint32 totalcount = 0;
     data << uint32(0);
 
-    // converting string that we try to find to lower case
-    std::wstring wsearchedname;
-    if (!Utf8toWStr(searchedname, wsearchedname))
-        return;
-
-    wstrToLower(wsearchedname);
-
-    BuildListAuctionItems(auctions, data, wsearchedname, listfrom, levelmin, levelmax, usable,
+    BuildListAuctionItems(auctions, data, filter.searchedName, listfrom, levelmin, levelmax, usable,
                           auctionSlotID, auctionMainCategory, auctionSubCategory, quality, count, totalcount, isFull != 0);
 
+#ifdef BUILD_METRICS
+    uint64 searchTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - searchStart).count();
+    metric::measurement meas("auction.search");
+    meas.add_field("duration_us", std::to_string(searchTime));
+    meas.add_field("candidates", std::to_string(auctions.size()));
+    meas.add_field("results", std::to_string(totalcount));
+    meas.add_field("auctions", std::to_string(auctionHouse->GetCount()));
+#endif
+
     data.put<uint32>(0, count);
     data << uint32(totalcount);
     data << uint32(300);                                    // 2.3.0 delay for next isFull request?
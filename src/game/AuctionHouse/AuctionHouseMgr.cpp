@@ -479,6 +479,83 @@ void AuctionHouseMgr::Update()
         mAuction.Update();
 }
 
+static uint64 MakeNameTrigram(std::wstring const& name, size_t pos)
+{
+    return (uint64(name[pos] & 0x1FFFFF) << 42) | (uint64(name[pos + 1] & 0x1FFFFF) << 21) | uint64(name[pos + 2] & 0x1FFFFF);
+}
+
+AuctionHouseMgr::ItemNameIndex const& AuctionHouseMgr::GetItemNameIndex(int32 localeIndex)
+{
+    std::map<int32, ItemNameIndex>::const_iterator itr = m_itemNameIndexes.find(localeIndex);
+    if (itr != m_itemNameIndexes.end())
+        return itr->second;
+
+    ItemNameIndex& index = m_itemNameIndexes[localeIndex];
+    index.names.resize(sItemStorage.GetMaxEntry());
+
+    for (uint32 id = 0; id < sItemStorage.GetMaxEntry(); ++id)
+    {
+        ItemPrototype const* proto = sItemStorage.LookupEntry<ItemPrototype>(id);
+        if (!proto)
+            continue;
+
+        std::string name = proto->Name1;
+        sObjectMgr.GetItemLocaleStrings(proto->ItemId, localeIndex, &name);
+
+        std::wstring& wname = index.names[id];
+        if (!Utf8toWStr(name, wname))
+        {
+            wname.clear();
+            continue;
+        }
+
+        wstrToLower(wname);
+
+        for (size_t i = 0; i + 3 <= wname.size(); ++i)
+        {
+            std::vector<uint32>& items = index.trigrams[MakeNameTrigram(wname, i)];
+            if (items.empty() || items.back() != id)
+                items.push_back(id);
+        }
+    }
+
+    DEBUG_LOG("AuctionHouseMgr: Built item name index for locale index %i, " SIZEFMTD " trigrams", localeIndex, index.trigrams.size());
+    return index;
+}
+
+bool AuctionHouseMgr::ItemNameFits(uint32 itemId, int32 localeIndex, std::wstring const& search)
+{
+    ItemNameIndex const& index = GetItemNameIndex(localeIndex);
+    if (itemId >= index.names.size())
+        return false;
+
+    return index.names[itemId].find(search) != std::wstring::npos;
+}
+
+void AuctionHouseMgr::FindItemsByName(int32 localeIndex, std::wstring const& search, std::vector<uint32>& items)
+{
+    ItemNameIndex const& index = GetItemNameIndex(localeIndex);
+
+    // the rarest trigram of the search gives the fewest candidates
+    std::vector<uint32> const* candidates = nullptr;
+    for (size_t i = 0; i + 3 <= search.size(); ++i)
+    {
+        auto itr = index.trigrams.find(MakeNameTrigram(search, i));
+        if (itr == index.trigrams.end())
+            return;
+
+        if (!candidates || itr->second.size() < candidates->size())
+            candidates = &itr->second;
+    }
+
+    if (!candidates)
+        return;
+
+    for (uint32 itemId : *candidates)
+        if (index.names[itemId].find(search) != std::wstring::npos)
+            items.push_back(itemId);
+}
+
 uint32 AuctionHouseMgr::GetAuctionHouseTeam(AuctionHouseEntry const* house)
 {
     // auction houses have faction field pointing to PLAYER,* factions,
@@ -571,6 +648,7 @@ void AuctionHouseObject::Update()
 
                 itr->second->DeleteFromDB();
                 MANGOS_ASSERT(!itr->second->itemGuidLow);   // already removed or send in mail at won
+                RemoveFromIndexes(itr->second);
                 delete itr->second;
                 AuctionsMap.erase(itr++);
                 continue;
@@ -589,6 +667,7 @@ void AuctionHouseObject::Update()
                     sAuctionMgr.SendAuctionExpiredMail(itr->second);
 
                     itr->second->DeleteFromDB();
+                    RemoveFromIndexes(itr->second);
                     delete itr->second;
                     AuctionsMap.erase(itr++);
                     continue;
@@ -602,42 +681,206 @@ void AuctionHouseObject::Update()
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount)
 {
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    BuildListItems(m_auctionsByBidder, player->GetGUIDLow(), data, listfrom, count, totalcount);
+}
+
+void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount)
+{
+    BuildListItems(m_auctionsByOwner, player->GetGUIDLow(), data, listfrom, count, totalcount);
+}
+
+void AuctionHouseObject::BuildListItems(AuctionIndex const& index, uint32 key, WorldPacket& data, uint32 listfrom, uint32& count, uint32& totalcount) const
+{
+    AuctionIndex::const_iterator bucket = index.find(key);
+    if (bucket == index.end())
+        return;
+
+    for (AuctionEntryMap::const_iterator itr = bucket->second.begin(); itr != bucket->second.end(); ++itr)
     {
         AuctionEntry* Aentry = itr->second;
         if (Aentry->moneyDeliveryTime)                      // skip pending sell auctions
             continue;
-        if (Aentry->bidder == player->GetGUIDLow())
+
+        if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
         {
-            if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
-            {
-                if (!Aentry->BuildAuctionInfo(data))
-                    continue;
-                ++count;
-            }
-            ++totalcount;
+            if (!Aentry->BuildAuctionInfo(data))
+                continue;
+            ++count;
         }
+        ++totalcount;
     }
 }
 
-void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount)
+void AuctionHouseObject::AddToIndexes(AuctionEntry* auction)
 {
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    if (auction->owner)
+        m_auctionsByOwner[auction->owner][auction->Id] = auction;
+    if (auction->bidder)
+        m_auctionsByBidder[auction->bidder][auction->Id] = auction;
+
+    m_auctionsByItem[auction->itemTemplate][auction->Id] = auction;
+
+    if (ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate))
     {
-        AuctionEntry* Aentry = itr->second;
-        if (Aentry->moneyDeliveryTime)                      // skip pending sell auctions
-            continue;
-        if (Aentry->owner == player->GetGUIDLow())
+        m_auctionsByClass[proto->Class][auction->Id] = auction;
+        m_auctionsBySubClass[(proto->Class << 16) | proto->SubClass][auction->Id] = auction;
+        m_auctionsByInventoryType[proto->InventoryType][auction->Id] = auction;
+        m_auctionsByQuality[proto->Quality][auction->Id] = auction;
+        m_auctionsByLevel[proto->RequiredLevel][auction->Id] = auction;
+    }
+}
+
+void AuctionHouseObject::RemoveFromIndexes(AuctionEntry* auction)
+{
+    if (auction->owner)
+        RemoveFromIndex(m_auctionsByOwner, auction->owner, auction->Id);
+    if (auction->bidder)
+        RemoveFromIndex(m_auctionsByBidder, auction->bidder, auction->Id);
+
+    RemoveFromIndex(m_auctionsByItem, auction->itemTemplate, auction->Id);
+
+    if (ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate))
+    {
+        RemoveFromIndex(m_auctionsByClass, proto->Class, auction->Id);
+        RemoveFromIndex(m_auctionsBySubClass, (proto->Class << 16) | proto->SubClass, auction->Id);
+        RemoveFromIndex(m_auctionsByInventoryType, proto->InventoryType, auction->Id);
+        RemoveFromIndex(m_auctionsByQuality, proto->Quality, auction->Id);
+        RemoveFromIndex(m_auctionsByLevel, proto->RequiredLevel, auction->Id);
+    }
+}
+
+void AuctionHouseObject::RemoveFromIndex(AuctionIndex& index, uint32 key, uint32 auctionId)
+{
+    AuctionIndex::iterator bucket = index.find(key);
+    if (bucket == index.end())
+        return;
+
+    bucket->second.erase(auctionId);
+    if (bucket->second.empty())
+        index.erase(bucket);
+}
+
+void AuctionHouseObject::SetBidder(AuctionEntry* auction, uint32 bidder)
+{
+    // auctions not (yet) in this house have no index entries
+    if (GetAuction(auction->Id) != auction)
+    {
+        auction->bidder = bidder;
+        return;
+    }
+
+    if (auction->bidder == bidder)
+        return;
+
+    if (auction->bidder)
+        RemoveFromIndex(m_auctionsByBidder, auction->bidder, auction->Id);
+
+    auction->bidder = bidder;
+
+    if (bidder)
+        m_auctionsByBidder[bidder][auction->Id] = auction;
+}
+
+void AuctionHouseObject::AddBucket(AuctionIndex const& index, uint32 key, AuctionBuckets& buckets)
+{
+    AuctionIndex::const_iterator bucket = index.find(key);
+    if (bucket != index.end())
+        buckets.push_back(&bucket->second);
+}
+
+void AuctionHouseObject::FindAuctions(AuctionSearchFilter const& filter, std::vector<AuctionEntry*>& auctions) const
+{
+    AuctionBuckets bestBuckets;
+    size_t bestCount = AuctionsMap.size();
+    bool indexed = false;
+
+    // every filter selects a set of index buckets, the one with the fewest auctions is used
+    auto selectBuckets = [&](AuctionBuckets& buckets)
+    {
+        size_t count = 0;
+        for (AuctionEntryMap const* bucket : buckets)
+            count += bucket->size();
+
+        if (!indexed || count < bestCount)
         {
-            if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
-            {
-                if (!Aentry->BuildAuctionInfo(data))
-                    continue;
-                ++count;
-            }
-            ++totalcount;
+            bestBuckets.swap(buckets);
+            bestCount = count;
+            indexed = true;
+        }
+    };
+
+    if (filter.itemClass != 0xffffffff)
+    {
+        AuctionBuckets buckets;
+        if (filter.itemSubClass != 0xffffffff)
+            AddBucket(m_auctionsBySubClass, (filter.itemClass << 16) | filter.itemSubClass, buckets);
+        else
+            AddBucket(m_auctionsByClass, filter.itemClass, buckets);
+        selectBuckets(buckets);
+    }
+
+    if (filter.inventoryType != 0xffffffff)
+    {
+        AuctionBuckets buckets;
+        AddBucket(m_auctionsByInventoryType, filter.inventoryType, buckets);
+        if (filter.inventoryType == INVTYPE_CHEST)          // robes are listed as chests
+            AddBucket(m_auctionsByInventoryType, INVTYPE_ROBE, buckets);
+        selectBuckets(buckets);
+    }
+
+    if (filter.quality != 0xffffffff)
+    {
+        AuctionBuckets buckets;
+        for (uint32 quality = filter.quality; quality < MAX_ITEM_QUALITY; ++quality)
+            AddBucket(m_auctionsByQuality, quality, buckets);
+        selectBuckets(buckets);
+    }
+
+    if (filter.levelMin != 0x00)
+    {
+        AuctionBuckets buckets;
+        for (AuctionIndex::const_iterator itr = m_auctionsByLevel.begin(); itr != m_auctionsByLevel.end(); ++itr)
+            if (itr->first >= filter.levelMin && (filter.levelMax == 0x00 || itr->first <= filter.levelMax))
+                buckets.push_back(&itr->second);
+        selectBuckets(buckets);
+    }
+
+    if (!filter.searchedName.empty())
+    {
+        AuctionBuckets buckets;
+        if (filter.searchedName.size() < 3)
+        {
+            // too short for the trigram index, check the names of the items on sale
+            for (AuctionIndex::const_iterator itr = m_auctionsByItem.begin(); itr != m_auctionsByItem.end(); ++itr)
+                if (sAuctionMgr.ItemNameFits(itr->first, filter.localeIndex, filter.searchedName))
+                    buckets.push_back(&itr->second);
+        }
+        else
+        {
+            std::vector<uint32> items;
+            sAuctionMgr.FindItemsByName(filter.localeIndex, filter.searchedName, items);
+            for (uint32 itemId : items)
+                AddBucket(m_auctionsByItem, itemId, buckets);
         }
+        selectBuckets(buckets);
+    }
+
+    if (!indexed)
+    {
+        auctions.reserve(AuctionsMap.size());
+        for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+            auctions.push_back(itr->second);
+        return;
     }
+
+    auctions.reserve(bestCount);
+    for (AuctionEntryMap const* bucket : bestBuckets)
+        for (AuctionEntryMap::const_iterator itr = bucket->begin(); itr != bucket->end(); ++itr)
+            auctions.push_back(itr->second);
+
+    // keep the id order of an unfiltered list, pages of unsorted results must not change between requests
+    if (bestBuckets.size() > 1)
+        std::sort(auctions.begin(), auctions.end(), [](AuctionEntry const* a, AuctionEntry const* b) { return a->Id < b->Id; });
 }
 
 int AuctionEntry::CompareAuctionEntry(uint32 column, const AuctionEntry* auc, Player* viewPlayer) const
@@ -860,10 +1103,7 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
                 }
             }
 
-            std::string name = proto->Name1;
-            sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
-
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
+            if (!wsearchedname.empty() && !sAuctionMgr.ItemNameFits(proto->ItemId, loc_idx, wsearchedname))
                 continue;
 
             if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
@@ -1042,7 +1282,7 @@ bool AuctionEntry::UpdateBid(uint32 newbid, Player* newbidder /*=nullptr*/)
             WorldSession::SendAuctionOutbiddedMail(this);
     }
 
-    bidder = newbidder ? newbidder->GetGUIDLow() : 0;
+    sAuctionMgr.GetAuctionsMap(auctionHouseEntry)->SetBidder(this, newbidder ? newbidder->GetGUIDLow() : 0);
     bid = newbid;
 
     if ((newbid < buyout) || (buyout == 0))                 // bid
@@ -87,6 +87,19 @@ struct AuctionEntry
     bool UpdateBid(uint32 newbid, Player* newbidder = nullptr);// true if normal bid, false if buyout, bidder==nullptr for generated bid
 };
 
+// browse request filters, 0xffffffff (0 for the levels) means not filtered
+struct AuctionSearchFilter
+{
+    std::wstring searchedName;                              // lower case
+    int32 localeIndex;
+    uint32 levelMin;
+    uint32 levelMax;
+    uint32 inventoryType;
+    uint32 itemClass;
+    uint32 itemSubClass;
+    uint32 quality;
+};
+
 // this class is used as auctionhouse instance
 class AuctionHouseObject
 {
@@ -110,6 +123,7 @@ class AuctionHouseObject
         {
             MANGOS_ASSERT(ah);
             AuctionsMap[ah->Id] = ah;
+            AddToIndexes(ah);
         }
 
         AuctionEntry* GetAuction(uint32 id) const
@@ -120,18 +134,50 @@ class AuctionHouseObject
 
         bool RemoveAuction(uint32 id)
         {
-            return AuctionsMap.erase(id) > 0;
+            AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+            if (itr == AuctionsMap.end())
+                return false;
+
+            RemoveFromIndexes(itr->second);
+            AuctionsMap.erase(itr);
+            return true;
         }
 
+        // changes the bidder of the auction, keeps the bidder index up to date
+        void SetBidder(AuctionEntry* auction, uint32 bidder);
+
         void Update();
 
+        // collects the auctions of the narrowest index matching the filter, candidates still need the full filter check
+        void FindAuctions(AuctionSearchFilter const& filter, std::vector<AuctionEntry*>& auctions) const;
+
         void BuildListBidderItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount);
         void BuildListOwnerItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount);
         void BuildListPendingSales(WorldPacket& data, Player* player, uint32& count);
 
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout = 0, uint32 deposit = 0, Player* pl = nullptr);
     private:
+        typedef std::unordered_map<uint32, AuctionEntryMap> AuctionIndex;
+        typedef std::vector<AuctionEntryMap const*> AuctionBuckets;
+
+        void AddToIndexes(AuctionEntry* auction);
+        void RemoveFromIndexes(AuctionEntry* auction);
+        void BuildListItems(AuctionIndex const& index, uint32 key, WorldPacket& data, uint32 listfrom, uint32& count, uint32& totalcount) const;
+
+        static void RemoveFromIndex(AuctionIndex& index, uint32 key, uint32 auctionId);
+        static void AddBucket(AuctionIndex const& index, uint32 key, AuctionBuckets& buckets);
+
         AuctionEntryMap AuctionsMap;
+
+        // secondary indexes of AuctionsMap, searches only visit the auctions of the matching buckets
+        AuctionIndex m_auctionsByOwner;
+        AuctionIndex m_auctionsByBidder;
+        AuctionIndex m_auctionsByItem;                      // item entry, used for name searches
+        AuctionIndex m_auctionsByClass;
+        AuctionIndex m_auctionsBySubClass;                  // class << 16 | subclass
+        AuctionIndex m_auctionsByInventoryType;
+        AuctionIndex m_auctionsByQuality;
+        AuctionIndex m_auctionsByLevel;                     // required level
 };
 
 class AuctionSorter
@@ -195,8 +241,21 @@ class AuctionHouseMgr
 
         void Update();
 
+        // lower case item names of a locale, prepared for auction house name searches
+        bool ItemNameFits(uint32 itemId, int32 localeIndex, std::wstring const& search);
+        void FindItemsByName(int32 localeIndex, std::wstring const& search, std::vector<uint32>& items);
+
     private:
+        struct ItemNameIndex
+        {
+            std::vector<std::wstring> names;                // by item entry
+            std::unordered_map<uint64, std::vector<uint32>> trigrams;   // item entries with the trigram in their name
+        };
+
+        ItemNameIndex const& GetItemNameIndex(int32 localeIndex);
+
         AuctionHouseObject  mAuctions[MAX_AUCTION_HOUSE_TYPE];
+        std::map<int32, ItemNameIndex> m_itemNameIndexes;   // by db locale index, built on first search
 
         ItemMap             mAitems;
 };
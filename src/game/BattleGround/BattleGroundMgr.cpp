@@ -241,6 +241,10 @@ GroupQueueInfo* BattleGroundQueue::AddGroup(Player* leader, Group* group, Battle
         // add GroupInfo to m_QueuedGroups
         m_queuedGroups[bracketId][index].push_back(queueInfo);
 
+        // rated teams are matched by rating, keep them in the rating index until invited
+        if (isRated)
+            m_ratedGroups[bracketId].emplace(arenaRating, queueInfo);
+
         // announce to world, this code needs mutex
         if (arenaType == ARENA_TYPE_NONE && !isRated && !isPremade && sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN))
         {
@@ -445,6 +449,8 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     if (group->players.empty())
     {
         m_queuedGroups[bracketId][index].erase(group_itr);
+        if (group->isRated)
+            RemoveFromRatingIndex(group, BattleGroundBracketId(bracketId));
         delete group;
     }
     // if group wasn't empty, so it wasn't deleted, and player have left a rated
@@ -1022,144 +1028,172 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
     }
     else if (bgTemplate->IsArena())
     {
-        // found out the minimum and maximum ratings the newly added team should battle against
+        RatedGroupsIndex& ratedGroups = m_ratedGroups[bracketId];
+        if (ratedGroups.size() < 2)
+            return;
+
+        // the longest waiting team has the widest rating window, nobody can accept a larger rating difference
+        GroupQueueInfo* longestWaiting = GetLongestWaitingRatedGroup(bracketId);
+        if (!longestWaiting)
+            return;
+
+        uint32 now = WorldTimer::getMSTime();
+        uint32 maxWindow = sBattleGroundMgr.GetRatingWindow(WorldTimer::getMSTimeDiff(longestWaiting->joinTime, now));
+
+        // find the team we search an opponent for
         // arenaRating is the rating of the latest joined team, or 0
-        // 0 is on (automatic update call) and we must set it to team's with longest wait time
-        if (!arenaRating)
+        // 0 is on (automatic update call) and we must search for the team with longest wait time
+        RatedGroupsIndex::iterator anchor = ratedGroups.end();
+        if (arenaRating)
         {
-            GroupQueueInfo* front1 = nullptr;
-            GroupQueueInfo* front2 = nullptr;
-            if (!m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].empty())
+            auto bounds = ratedGroups.equal_range(arenaRating);
+            for (RatedGroupsIndex::iterator itr = bounds.first; itr != bounds.second; ++itr)
             {
-                front1 = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].front();
-                arenaRating = front1->arenaTeamRating;
+                if (anchor == ratedGroups.end() || itr->second->joinTime < anchor->second->joinTime)
+                    anchor = itr;
             }
+        }
 
-            if (!m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].empty())
+        if (anchor == ratedGroups.end())
+        {
+            auto bounds = ratedGroups.equal_range(longestWaiting->arenaTeamRating);
+            for (RatedGroupsIndex::iterator itr = bounds.first; itr != bounds.second && anchor == ratedGroups.end(); ++itr)
             {
-                front2 = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].front();
-                arenaRating = front2->arenaTeamRating;
+                if (itr->second == longestWaiting)
+                    anchor = itr;
             }
 
-            if (front1 && front2)
-            {
-                if (front1->joinTime < front2->joinTime)
-                    arenaRating = front1->arenaTeamRating;
-            }
-            else if (!front1 && !front2)
-                return; // queues are empty
+            if (anchor == ratedGroups.end())
+                return;
         }
 
-        // set rating range
-        uint32 arenaMinRating = (arenaRating <= sBattleGroundMgr.GetMaxRatingDifference()) ? 0 : arenaRating - sBattleGroundMgr.GetMaxRatingDifference();
-        uint32 arenaMaxRating = arenaRating + sBattleGroundMgr.GetMaxRatingDifference();
-        // if max rating difference is set and the time past since server startup is greater than the rating discard time
-        // (after what time the ratings aren't taken into account when making teams) then
-        // the discard time is current_time - time_to_discard, teams that joined after that, will have their ratings taken into account
-        // else leave the discard time on 0, this way all ratings will be discarded
-        uint32 discardTime = WorldTimer::getMSTime() - sBattleGroundMgr.GetRatingDiscardTimer();
+        GroupQueueInfo* anchorGroup = anchor->second;
+        uint32 anchorWindow = sBattleGroundMgr.GetRatingWindow(WorldTimer::getMSTimeDiff(anchorGroup->joinTime, now));
 
-        // we need to find 2 teams which will play next game
+        // walk the index outwards from the anchor, the closest rating accepted by either team wins
+        // the window of a team grows with its time in queue, so long waiting teams accept wider differences
+        RatedGroupsIndex::iterator lower = anchor;
+        RatedGroupsIndex::iterator upper = std::next(anchor);
+        RatedGroupsIndex::iterator opponent = ratedGroups.end();
+        while (lower != ratedGroups.begin() || upper != ratedGroups.end())
+        {
+            RatedGroupsIndex::iterator candidate;
+            uint32 difference;
+            if (upper == ratedGroups.end() || (lower != ratedGroups.begin() && anchor->first - std::prev(lower)->first <= upper->first - anchor->first))
+            {
+                candidate = --lower;
+                difference = anchor->first - candidate->first;
+            }
+            else
+            {
+                candidate = upper++;
+                difference = candidate->first - anchor->first;
+            }
 
-        GroupsQueueType::iterator itr_team[PVP_TEAM_COUNT];
+            if (difference > maxWindow)
+                break;
 
-        // optimalization : --- we dont need to use selection_pools - each update we select max 2 groups
+            if (candidate->second->isInvitedToBgInstanceGuid)
+                continue;
 
-        for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; ++i)
-        {
-            // take the group that joined first
-            itr_team[i] = m_queuedGroups[bracketId][i].begin();
-            for (; itr_team[i] != m_queuedGroups[bracketId][i].end(); ++(itr_team[i]))
+            if (difference <= anchorWindow || difference <= sBattleGroundMgr.GetRatingWindow(WorldTimer::getMSTimeDiff(candidate->second->joinTime, now)))
             {
-                // if group match conditions, then add it to pool
-                if (!(*itr_team[i])->isInvitedToBgInstanceGuid
-                        && (((*itr_team[i])->arenaTeamRating >= arenaMinRating && (*itr_team[i])->arenaTeamRating <= arenaMaxRating)
-                            || (*itr_team[i])->joinTime < discardTime))
-                {
-                    m_selectionPools[i].AddGroup((*itr_team[i]), maxPlayersPerTeam, 0);
-                    // break for cycle to be able to start selecting another group from same faction queue
-                    break;
-                }
+                opponent = candidate;
+                break;
             }
         }
-        // now we are done if we have 2 groups - ali vs horde!
-        // if we don't have, we must try to continue search in same queue
-        // tmp variables are correctly set
-        // this code isn't much userfriendly - but it is supposed to continue search for mathing group in HORDE queue
-        if (m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() == 0 && m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount())
-        {
-            itr_team[TEAM_INDEX_ALLIANCE] = itr_team[TEAM_INDEX_HORDE];
-            ++itr_team[TEAM_INDEX_ALLIANCE];
 
-            for (; itr_team[TEAM_INDEX_ALLIANCE] != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].end(); ++(itr_team[TEAM_INDEX_ALLIANCE]))
-            {
-                if (!(*itr_team[TEAM_INDEX_ALLIANCE])->isInvitedToBgInstanceGuid
-                        && (((*itr_team[TEAM_INDEX_ALLIANCE])->arenaTeamRating >= arenaMinRating && (*itr_team[TEAM_INDEX_ALLIANCE])->arenaTeamRating <= arenaMaxRating)
-                            || (*itr_team[TEAM_INDEX_ALLIANCE])->joinTime < discardTime))
-                {
-                    m_selectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*itr_team[TEAM_INDEX_ALLIANCE]), maxPlayersPerTeam, 0);
-                    break;
-                }
-            }
+        if (opponent == ratedGroups.end())
+            return;
+
+        GroupQueueInfo* opponentGroup = opponent->second;
+
+        BattleGround* arena = sBattleGroundMgr.CreateNewBattleGround(bgTypeId, bracketEntry, arenaType, true);
+        if (!arena)
+        {
+            sLog.outError("BattlegroundQueue::Update couldn't create arena instance for rated arena match!");
+            return;
         }
-        // this code isn't much userfriendly - but it is supposed to continue search for mathing group in ALLIANCE queue
-        if (m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount() == 0 && m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())
+
+        // both teams leave the rating index, they stay in the faction queues until they enter or the invite expires
+        ratedGroups.erase(anchor);
+        ratedGroups.erase(opponent);
+
+        // the anchor keeps its side, same faction opponents play for the other side
+        GroupQueueInfo* teams[PVP_TEAM_COUNT];
+        uint8 anchorIdx = anchorGroup->groupTeam == HORDE ? TEAM_INDEX_HORDE : TEAM_INDEX_ALLIANCE;
+        teams[anchorIdx] = anchorGroup;
+        teams[(anchorIdx + 1) % PVP_TEAM_COUNT] = opponentGroup;
+
+        teams[TEAM_INDEX_ALLIANCE]->opponentsTeamRating = teams[TEAM_INDEX_HORDE]->arenaTeamRating;
+        DEBUG_LOG("setting oposite teamrating for team %u to %u", teams[TEAM_INDEX_ALLIANCE]->arenaTeamId, teams[TEAM_INDEX_ALLIANCE]->opponentsTeamRating);
+        teams[TEAM_INDEX_HORDE]->opponentsTeamRating = teams[TEAM_INDEX_ALLIANCE]->arenaTeamRating;
+        DEBUG_LOG("setting oposite teamrating for team %u to %u", teams[TEAM_INDEX_HORDE]->arenaTeamId, teams[TEAM_INDEX_HORDE]->opponentsTeamRating);
+
+        // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
+        for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
         {
-            itr_team[TEAM_INDEX_HORDE] = itr_team[TEAM_INDEX_ALLIANCE];
-            ++itr_team[TEAM_INDEX_HORDE];
+            Team side = i == TEAM_INDEX_ALLIANCE ? ALLIANCE : HORDE;
+            if (teams[i]->groupTeam == side)
+                continue;
 
-            for (; itr_team[TEAM_INDEX_HORDE] != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].end(); ++(itr_team[TEAM_INDEX_HORDE]))
-            {
-                if (!(*itr_team[TEAM_INDEX_HORDE])->isInvitedToBgInstanceGuid
-                        && (((*itr_team[TEAM_INDEX_HORDE])->arenaTeamRating >= arenaMinRating && (*itr_team[TEAM_INDEX_HORDE])->arenaTeamRating <= arenaMaxRating)
-                            || (*itr_team[TEAM_INDEX_HORDE])->joinTime < discardTime))
-                {
-                    m_selectionPools[TEAM_INDEX_HORDE].AddGroup((*itr_team[TEAM_INDEX_HORDE]), maxPlayersPerTeam, 0);
-                    break;
-                }
-            }
+            GroupsQueueType& oldQueue = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + (i + 1) % PVP_TEAM_COUNT];
+            GroupsQueueType::iterator itr = std::find(oldQueue.begin(), oldQueue.end(), teams[i]);
+            if (itr != oldQueue.end())
+                oldQueue.erase(itr);
+            m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].push_front(teams[i]);
         }
 
-        // if we have 2 teams, then start new arena and invite players!
-        if (m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() && m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount())
-        {
-            BattleGround* arena = sBattleGroundMgr.CreateNewBattleGround(bgTypeId, bracketEntry, arenaType, true);
-            if (!arena)
-            {
-                sLog.outError("BattlegroundQueue::Update couldn't create arena instance for rated arena match!");
-                return;
-            }
+        InviteGroupToBg(teams[TEAM_INDEX_ALLIANCE], arena, ALLIANCE);
+        InviteGroupToBg(teams[TEAM_INDEX_HORDE], arena, HORDE);
 
-            (*(itr_team[TEAM_INDEX_ALLIANCE]))->opponentsTeamRating = (*(itr_team[TEAM_INDEX_HORDE]))->arenaTeamRating;
-            DEBUG_LOG("setting oposite teamrating for team %u to %u", (*(itr_team[TEAM_INDEX_ALLIANCE]))->arenaTeamId, (*(itr_team[TEAM_INDEX_ALLIANCE]))->opponentsTeamRating);
-            (*(itr_team[TEAM_INDEX_HORDE]))->opponentsTeamRating = (*(itr_team[TEAM_INDEX_ALLIANCE]))->arenaTeamRating;
-            DEBUG_LOG("setting oposite teamrating for team %u to %u", (*(itr_team[TEAM_INDEX_HORDE]))->arenaTeamId, (*(itr_team[TEAM_INDEX_HORDE]))->opponentsTeamRating);
+        DEBUG_LOG("Starting rated arena match!");
 
-            // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
-            if ((*(itr_team[TEAM_INDEX_ALLIANCE]))->groupTeam != ALLIANCE)
-            {
-                // add to alliance queue
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].push_front(*(itr_team[TEAM_INDEX_ALLIANCE]));
-                // erase from horde queue
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].erase(itr_team[TEAM_INDEX_ALLIANCE]);
-                itr_team[TEAM_INDEX_ALLIANCE] = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].begin();
-            }
+        arena->StartBattleGround();
+    }
+}
 
-            if ((*(itr_team[TEAM_INDEX_HORDE]))->groupTeam != HORDE)
-            {
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].push_front(*(itr_team[TEAM_INDEX_HORDE]));
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_team[TEAM_INDEX_HORDE]);
-                itr_team[TEAM_INDEX_HORDE] = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].begin();
-            }
+/**
+  Method that removes a rated group from the rating index
 
-            InviteGroupToBg(*(itr_team[TEAM_INDEX_ALLIANCE]), arena, ALLIANCE);
-            InviteGroupToBg(*(itr_team[TEAM_INDEX_HORDE]), arena, HORDE);
+  @param    group queue info
+  @param    bracket id
+*/
+void BattleGroundQueue::RemoveFromRatingIndex(GroupQueueInfo* queueInfo, BattleGroundBracketId bracketId)
+{
+    auto bounds = m_ratedGroups[bracketId].equal_range(queueInfo->arenaTeamRating);
+    for (RatedGroupsIndex::iterator itr = bounds.first; itr != bounds.second; ++itr)
+    {
+        if (itr->second == queueInfo)
+        {
+            m_ratedGroups[bracketId].erase(itr);
+            return;
+        }
+    }
+}
+
+/**
+  Function that returns the rated group with the longest time in queue, the faction queues are ordered by join time
 
-            DEBUG_LOG("Starting rated arena match!");
+  @param    bracket id
+*/
+GroupQueueInfo* BattleGroundQueue::GetLongestWaitingRatedGroup(BattleGroundBracketId bracketId) const
+{
+    GroupQueueInfo* longestWaiting = nullptr;
+    for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; ++i)
+    {
+        for (GroupQueueInfo* queueInfo : m_queuedGroups[bracketId][i])
+        {
+            // skirmish groups share the premade lists but are not indexed in m_ratedGroups
+            if (queueInfo->isInvitedToBgInstanceGuid || !queueInfo->isRated)
+                continue;
 
-            arena->StartBattleGround();
+            if (!longestWaiting || queueInfo->joinTime < longestWaiting->joinTime)
+                longestWaiting = queueInfo;
+            break;
         }
     }
+    return longestWaiting;
 }
 
 /*********************************************************/
@@ -1328,7 +1362,7 @@ void BattleGroundMgr::Update(uint32 diff)
     }
 
     // if rating difference counts, maybe force-update queues
-    if (sWorld.getConfig(CONFIG_UINT32_ARENA_MAX_RATING_DIFFERENCE) && sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER))
+    if (sWorld.getConfig(CONFIG_UINT32_ARENA_MAX_RATING_DIFFERENCE) && (sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER) || sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_WINDOW_GROWTH)))
     {
         // it's time to force update
         if (m_nextRatingDiscardUpdate < diff)
@@ -1342,6 +1376,9 @@ void BattleGroundMgr::Update(uint32 diff)
                         BattleGroundMgr::BgArenaType(BattleGroundQueueTypeId(qtype)), true, 0);
 
             m_nextRatingDiscardUpdate = sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER);
+            // rating windows widen every minute, recheck the teams at least that often
+            if (sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_WINDOW_GROWTH) && (!m_nextRatingDiscardUpdate || m_nextRatingDiscardUpdate > MINUTE * IN_MILLISECONDS))
+                m_nextRatingDiscardUpdate = MINUTE * IN_MILLISECONDS;
         }
         else
             m_nextRatingDiscardUpdate -= diff;
@@ -2642,6 +2679,21 @@ uint32 BattleGroundMgr::GetRatingDiscardTimer() const
     return sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER);
 }
 
+/**
+  Function that returns the rating difference a rated team accepts after the given time in queue
+  - the window starts at max rating difference and grows by the configured amount per minute
+  - after the rating discard timer ratings are not taken into account at all
+
+  @param    time in queue
+*/
+uint32 BattleGroundMgr::GetRatingWindow(uint32 waitTime) const
+{
+    if (waitTime >= GetRatingDiscardTimer())
+        return std::numeric_limits<uint32>::max();
+
+    return GetMaxRatingDifference() + waitTime / MINUTE / IN_MILLISECONDS * sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_WINDOW_GROWTH);
+}
+
 /**
   Function that returns the premature finish time
 */
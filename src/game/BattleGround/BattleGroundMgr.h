@@ -115,6 +115,13 @@ class BattleGroundQueue
         */
         GroupsQueueType m_queuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
 
+        // rated arena teams waiting for an invite, ordered by team rating (both factions, as rated arenas may be same faction)
+        typedef std::multimap<uint32, GroupQueueInfo*> RatedGroupsIndex;
+        RatedGroupsIndex m_ratedGroups[MAX_BATTLEGROUND_BRACKETS];
+
+        void RemoveFromRatingIndex(GroupQueueInfo* /*groupInfo*/, BattleGroundBracketId /*bracketId*/);
+        GroupQueueInfo* GetLongestWaitingRatedGroup(BattleGroundBracketId /*bracketId*/) const;
+
         // class to select and invite groups to bg
         class SelectionPool
         {
@@ -238,6 +245,7 @@ class BattleGroundMgr
         void ScheduleQueueUpdate(uint32 /*arenaRating*/, ArenaType /*arenaType*/, BattleGroundQueueTypeId /*bgQueueTypeId*/, BattleGroundTypeId /*bgTypeId*/, BattleGroundBracketId /*bracketId*/);
         uint32 GetMaxRatingDifference() const;
         uint32 GetRatingDiscardTimer()  const;
+        uint32 GetRatingWindow(uint32 /*waitTime*/) const;
         uint32 GetPrematureFinishTime() const;
 
         void InitAutomaticArenaPointDistribution();
@@ -218,6 +218,39 @@ void ThreatContainer::clearReferences()
         delete (*i);
     }
     iThreatList.clear();
+    iSlotByGuid.clear();
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileReference)
+{
+    iSlotByGuid[hostileReference->getUnitGuid()] = iThreatList.size();
+    iThreatList.push_back(hostileReference);
+    iChanged = true;
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* ref)
+{
+    auto itr = iSlotByGuid.find(ref->getUnitGuid());
+    if (itr == iSlotByGuid.end() || iThreatList[itr->second] != ref)
+        return;
+
+    uint32 slot = itr->second;
+    iSlotByGuid.erase(itr);
+    // keep order, entries behind only shift by one
+    iThreatList.erase(iThreatList.begin() + slot);
+    updateSlots(slot);
+}
+
+//============================================================
+
+void ThreatContainer::updateSlots(uint32 from)
+{
+    for (uint32 i = from; i < iThreatList.size(); ++i)
+        iSlotByGuid[iThreatList[i]->getUnitGuid()] = i;
 }
 
 //============================================================
@@ -228,13 +261,11 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim)
     if (!victim)
         return nullptr;
 
-    ObjectGuid guid = victim->GetObjectGuid();
-
-    for (ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-        if ((*i)->getUnitGuid() == guid)
-            return (*i);
+    auto itr = iSlotByGuid.find(victim->GetObjectGuid());
+    if (itr == iSlotByGuid.end())
+        return nullptr;
 
-    return nullptr;
+    return iThreatList[itr->second];
 }
 
 //============================================================
@@ -289,9 +320,9 @@ void ThreatContainer::modifyAllThreatPercent(int32 threatPercent)
 
 void ThreatContainer::update(bool force, bool isPlayer)
 {
-    if ((iDirty || force || isPlayer) && iThreatList.size() > 1)
+    if ((iDirty || iChanged || force || isPlayer) && iThreatList.size() > 1)
     {
-        iThreatList.sort([&](const HostileReference* lhs, const HostileReference* rhs)->bool
+        auto compare = [&](const HostileReference* lhs, const HostileReference* rhs)->bool
         {
             Unit* owner = lhs->getSource()->getOwner();
             if (isPlayer)
@@ -321,9 +352,35 @@ void ThreatContainer::update(bool force, bool isPlayer)
             if (lhs->GetHostileState() != rhs->GetHostileState())
                 return lhs->GetHostileState() > rhs->GetHostileState();
             return lhs->getThreat() > rhs->getThreat(); // reverse sorting
-        });
+        };
+
+        if (iDirty)
+        {
+            std::stable_sort(iThreatList.begin(), iThreatList.end(), compare);
+            updateSlots(0);
+        }
+        else
+        {
+            // list is sorted from previous update apart from the changed entries - insertion pass only moves those
+            uint32 firstMoved = iThreatList.size();
+            for (uint32 i = 1; i < iThreatList.size(); ++i)
+            {
+                HostileReference* ref = iThreatList[i];
+                uint32 j = i;
+                for (; j > 0 && compare(ref, iThreatList[j - 1]); --j)
+                    iThreatList[j] = iThreatList[j - 1];
+
+                if (j != i)
+                {
+                    iThreatList[j] = ref;
+                    firstMoved = std::min(firstMoved, j);
+                }
+            }
+            updateSlots(firstMoved);
+        }
     }
     iDirty = false;
+    iChanged = false;
 }
 
 //============================================================
@@ -341,9 +398,6 @@ HostileReference* ThreatContainer::selectNextVictim(Unit* attacker, HostileRefer
     if (suppressRanged && currentVictim)
         currentVictimInMelee = attacker->CanReachWithMeleeAttack(currentVictim->getTarget());
 
-    ThreatList::const_iterator lastRef = iThreatList.end();
-    --lastRef;
-
     for (ThreatList::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
     {
         currentRef = (*iter);
@@ -661,9 +715,8 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent& threatRefStat
     switch (threatRefStatusChangeEvent.getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if ((getCurrentVictim() == hostileReference && threatRefStatusChangeEvent.getFValue() < 0.0f) ||
-                    (getCurrentVictim() != hostileReference && threatRefStatusChangeEvent.getFValue() > 0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            if (hostileReference->isOnline())
+                iThreatContainer.setChanged();              // the order in the threat list might have changed
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if (!hostileReference->isOnline())
@@ -25,7 +25,8 @@
 #include "Entities/UnitEvents.h"
 #include "Util/Timer.h"
 #include "Entities/ObjectGuid.h"
-#include <list>
+#include <vector>
+#include <unordered_map>
 
 //==============================================================
 
@@ -147,12 +148,13 @@ class HostileReference : public Reference<Unit, ThreatManager>
 //==============================================================
 class ThreatManager;
 
-typedef std::list<HostileReference*> ThreatList;
+// Kept ordered by threat (most hated first), contiguous so that the per update walk stays in cache
+typedef std::vector<HostileReference*> ThreatList;
 
 class ThreatContainer
 {
     public:
-        ThreatContainer() { iDirty = false; }
+        ThreatContainer() : iDirty(false), iChanged(false) {}
         ~ThreatContainer() { clearReferences(); }
 
         HostileReference* addThreat(Unit* victim, float threat);
@@ -162,7 +164,10 @@ class ThreatContainer
 
         HostileReference* selectNextVictim(Unit* attacker, HostileReference* currentVictim);
 
+        // whole order may be broken (taunt, suppression) - full sort on next update
         void setDirty(bool dirty) { iDirty = dirty; }
+        // only some entries moved (threat change, new reference) - they are shifted in place on next update
+        void setChanged() { iChanged = true; }
 
         bool isDirty() const { return iDirty; }
 
@@ -176,15 +181,19 @@ class ThreatContainer
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* ref) { iThreatList.remove(ref); }
-        void addReference(HostileReference* hostileReference) { iThreatList.push_back(hostileReference); }
+        void remove(HostileReference* ref);
+        void addReference(HostileReference* hostileReference);
         void clearReferences();
         // Sort the list if necessary
         void update(bool force, bool isPlayer);
+        // Refresh guid index for all entries starting at given position
+        void updateSlots(uint32 from);
 
         ThreatList iThreatList;
+        std::unordered_map<ObjectGuid, uint32> iSlotByGuid; // victim guid -> position in iThreatList
     private:
         bool iDirty;
+        bool iChanged;
 };
 
 //=================================================
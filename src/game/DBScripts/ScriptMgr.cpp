@@ -1742,6 +1742,12 @@ bool ScriptAction::HandleScriptStep()
         WorldObject* pTarget = data.second;
         Object* pSourceOrItem = pSource ? pSource : itemSource;
 
+        // scripted creatures must not wait for their next idle update to act
+        if (pSource && pSource->GetTypeId() == TYPEID_UNIT)
+            static_cast<Creature*>(pSource)->SetFullUpdateTier();
+        if (pTarget && pTarget->GetTypeId() == TYPEID_UNIT)
+            static_cast<Creature*>(pTarget)->SetFullUpdateTier();
+
         bool result = ExecuteDbscriptCommand(pSource, pTarget, pSourceOrItem, buddyFound);
         if (result == true)
             finalResult = true;
@@ -45,6 +45,7 @@
 #include "Grids/GridNotifiersImpl.h"
 #include "Grids/CellImpl.h"
 #include "Movement/MoveSplineInit.h"
+#include "Movement/MoveSpline.h"
 #include "Entities/CreatureLinkingMgr.h"
 #include "Entities/Transports.h"
 #include "Maps/SpawnManager.h"
@@ -150,6 +151,7 @@ Creature::Creature(CreatureSubtype subtype) : Unit(),
     m_settings(this),
     m_countSpawns(false),
     m_creatureGroup(nullptr), m_imposedCooldown(false),
+    m_updateTier(CREATURE_UPDATE_TIER_FULL), m_fullUpdateTierRequested(false), m_idleUpdateDiff(0),
     m_creatureInfo(nullptr)
 {
     m_valuesCount = UNIT_END;
@@ -286,7 +288,7 @@ void Creature::RemoveCorpse(bool inPlace)
         GetMap()->GetCreatureLinkingHolder()->DoCreatureLinkingEvent(LINKING_EVENT_DESPAWN, this);
 
     if (InstanceData* mapInstance = GetInstanceData())
-        mapInstance->OnCreatureDespawn(this);
+        GetMap()->ExecuteSerialized([mapInstance, this](Map*) { mapInstance->OnCreatureDespawn(this); });
 
     // script can set time (in seconds) explicit, override the original
     if (respawnDelay)
@@ -718,8 +720,16 @@ uint32 Creature::ChooseDisplayId(const CreatureInfo* cinfo, const CreatureData*
     return display_id;
 }
 
-void Creature::Update(const uint32 diff)
+void Creature::Update(const uint32 update_diff)
 {
+    // idle creatures only collect the diff until the interval passed or something promotes them to full rate
+    m_idleUpdateDiff += update_diff;
+    if (m_updateTier == CREATURE_UPDATE_TIER_IDLE && !m_fullUpdateTierRequested && m_idleUpdateDiff < sWorld.getConfig(CONFIG_UINT32_CREATURE_IDLE_UPDATE_INTERVAL))
+        return;
+
+    uint32 const diff = m_idleUpdateDiff;
+    m_idleUpdateDiff = 0;
+
     switch (m_deathState)
     {
         case JUST_ALIVED:
@@ -752,7 +762,7 @@ void Creature::Update(const uint32 diff)
 
                 // Inform Instance Data
                 if (InstanceData* mapInstance = GetInstanceData())
-                    mapInstance->OnCreatureRespawn(this);
+                    GetMap()->ExecuteSerialized([mapInstance, this](Map*) { mapInstance->OnCreatureRespawn(this); });
 
                 if (m_isCreatureLinkingTrigger)
                     GetMap()->GetCreatureLinkingHolder()->DoCreatureLinkingEvent(LINKING_EVENT_RESPAWN, this);
@@ -764,7 +774,7 @@ void Creature::Update(const uint32 diff)
 
                 if (GetObjectGuid().GetHigh() != HIGHGUID_PET)
                     if (uint16 poolid = sPoolMgr.IsPartOfAPool<Creature>(GetDbGuid()))
-                        sPoolMgr.UpdatePool<Creature>(*GetMap()->GetPersistentState(), poolid, GetDbGuid());
+                        GetMap()->ExecuteSerialized([poolid, dbGuid = GetDbGuid()](Map* map) { sPoolMgr.UpdatePool<Creature>(*map->GetPersistentState(), poolid, dbGuid); });
             }
             break;
         }
@@ -798,20 +808,55 @@ void Creature::Update(const uint32 diff)
         default:
             break;
     }
+
+    // a promotion requested while this update ran must not be overwritten
+    bool fullRequested = m_fullUpdateTierRequested.exchange(false);
+    m_updateTier = !fullRequested && CanUseIdleUpdateTier() ? CREATURE_UPDATE_TIER_IDLE : CREATURE_UPDATE_TIER_FULL;
+}
+
+bool Creature::CanUseIdleUpdateTier()
+{
+    if (!sWorld.getConfig(CONFIG_UINT32_CREATURE_IDLE_UPDATE_INTERVAL) || !IsInWorld())
+        return false;
+
+    // controlled, fighting, moving or casting creatures and anything with a dedicated script keep the full rate
+    if (GetMasterGuid() || isActiveObject() || IsInCombat() || !movespline->Finalized() || IsNonMeleeSpellCasted(false) || GetScriptId())
+        return false;
+
+    // auras fire at most one periodic tick per update, only suspended (passive/permanent) holders allow skipping updates
+    if (!m_updatedAuraHolders.empty())
+        return false;
+
+    float distance = sWorld.getConfig(CONFIG_FLOAT_CREATURE_IDLE_UPDATE_DISTANCE);
+    for (ObjectGuid const& guid : GetClientGuidsIAmAt())
+    {
+        if (Player* player = GetMap()->GetPlayer(guid))
+            if (IsWithinDist(player, distance))
+                return false;
+    }
+
+    return true;
+}
+
+void Creature::UpdateTierOnApproach(Unit const* unit)
+{
+    if (m_updateTier != CREATURE_UPDATE_TIER_FULL && IsWithinDist(unit, sWorld.getConfig(CONFIG_FLOAT_CREATURE_IDLE_UPDATE_DISTANCE)))
+        SetFullUpdateTier();
 }
 
 void Creature::RegenerateAll(uint32 diff)
 {
+    // idle creatures are updated with several regen periods at once, each elapsed one gets its tick
     m_regenTimer += diff;
-    if (m_regenTimer < REGEN_TIME_FULL_UNIT)
-        return;
-
-    if (!IsInCombat() || GetCombatManager().IsEvadeRegen())
-        RegenerateHealth();
+    while (m_regenTimer >= REGEN_TIME_FULL_UNIT)
+    {
+        if (!IsInCombat() || GetCombatManager().IsEvadeRegen())
+            RegenerateHealth();
 
-    RegeneratePower(REGEN_TIME_FULL_UNIT / 1000);
+        RegeneratePower(REGEN_TIME_FULL_UNIT / 1000);
 
-    m_regenTimer -= REGEN_TIME_FULL_UNIT;
+        m_regenTimer -= REGEN_TIME_FULL_UNIT;
+    }
 }
 
 void Creature::RegeneratePower(float timerMultiplier)
@@ -27,6 +27,7 @@
 #include "Entities/CreatureSpellList.h"
 #include "Entities/CreatureSettings.h"
 
+#include <atomic>
 #include <list>
 #include <memory>
 #include <optional>
@@ -404,6 +405,14 @@ enum RegenStatsFlags
     REGEN_FLAG_POWER                = 0x008,
 };
 
+// Update level of detail, see Creature::Update
+enum CreatureUpdateTier
+{
+    CREATURE_UPDATE_TIER_FULL       = 0,                    // updated every map tick
+    CREATURE_UPDATE_TIER_IDLE       = 1,                    // updated every CreatureIdleUpdateInterval with the accumulated diff
+    MAX_CREATURE_UPDATE_TIER
+};
+
 // Vendors
 struct VendorItem
 {
@@ -577,6 +586,12 @@ class Creature : public Unit
 
         void Update(const uint32 diff) override;  // overwrite Unit::Update
 
+        CreatureUpdateTier GetUpdateTier() const { return m_updateTier; }
+        // back to full rate, the time skipped so far is applied at the next update
+        // may be called from other threads, the creature picks the request up in its own update
+        void SetFullUpdateTier() { m_fullUpdateTierRequested = true; }
+        void UpdateTierOnApproach(Unit const* unit);
+
         virtual void RegenerateAll(uint32 update_diff);
         uint32 GetEquipmentId() const { return m_equipmentId; }
 
@@ -905,6 +920,7 @@ class Creature : public Unit
         void UnsummonCleanup(); // cleans up data before unsummon of various creatures
 
         bool IsCorpseExpired() const;
+        bool CanUseIdleUpdateTier();
 
         // vendor items
         VendorItemCounts m_vendorItemCounts;
@@ -974,6 +990,10 @@ class Creature : public Unit
 
         bool m_imposedCooldown;
 
+        std::atomic<CreatureUpdateTier> m_updateTier;       // only written by the creature's own update
+        std::atomic<bool> m_fullUpdateTierRequested;
+        uint32 m_idleUpdateDiff;                            // (msecs) time not yet passed to the update
+
     private:
         GridReference<Creature> m_gridRef;
         CreatureInfo const* m_creatureInfo;                 // in difficulty mode > 0 can different from ObjMgr::GetCreatureTemplate(GetEntry())
@@ -412,6 +412,14 @@ void CreatureLinkingHolder::DoCreatureLinkingEvent(CreatureLinkingEvent eventTyp
     if (eventType == LINKING_EVENT_AGGRO && !pEnemy)
         return;
 
+    // holders and linked creatures are map wide state, process the event once the parallel pass finished
+    Map* map = pSource->GetMap();
+    if (map->IsUpdatingInParallel())
+    {
+        map->ExecuteSerialized([this, eventType, pSource, pEnemy](Map*) { DoCreatureLinkingEvent(eventType, pSource, pEnemy); });
+        return;
+    }
+
     uint32 eventFlagFilter = 0;
     uint32 reverseEventFlagFilter = 0;
 
@@ -743,7 +743,7 @@ void GameObject::Update(const uint32 diff)
             {
                 // if part of pool, let pool system schedule new spawn instead of just scheduling respawn
                 if (uint16 poolid = sPoolMgr.IsPartOfAPool<GameObject>(GetDbGuid()))
-                    sPoolMgr.UpdatePool<GameObject>(*GetMap()->GetPersistentState(), poolid, GetDbGuid());
+                    GetMap()->ExecuteSerialized([poolid, dbGuid = GetDbGuid()](Map* map) { sPoolMgr.UpdatePool<GameObject>(*map->GetPersistentState(), poolid, dbGuid); });
             }
 
             // can be not in world at pool despawn
@@ -816,10 +816,10 @@ void GameObject::Delete()
         AI()->JustDespawned();
 
     if (InstanceData* iData = GetMap()->GetInstanceData())
-        iData->OnObjectDespawn(this);
+        GetMap()->ExecuteSerialized([iData, this](Map*) { iData->OnObjectDespawn(this); });
 
     if (uint16 poolid = sPoolMgr.IsPartOfAPool<GameObject>(GetDbGuid()))
-        sPoolMgr.UpdatePool<GameObject>(*GetMap()->GetPersistentState(), poolid, GetDbGuid());
+        GetMap()->ExecuteSerialized([poolid, dbGuid = GetDbGuid()](Map* map) { sPoolMgr.UpdatePool<GameObject>(*map->GetPersistentState(), poolid, dbGuid); });
     else
         AddObjectToRemoveList();
 
@@ -2795,7 +2795,7 @@ void GameObject::AIM_Initialize()
         AI()->JustSpawned();
 
     if (InstanceData* iData = GetMap()->GetInstanceData())
-        iData->OnObjectSpawn(this);
+        GetMap()->ExecuteSerialized([iData, this](Map*) { iData->OnObjectSpawn(this); });
 }
 
 bool GameObject::IsAtInteractDistance(Player const* player, uint32 maxRange) const
@@ -58,6 +58,7 @@ Object::Object(): m_updateFlag(0), m_itsNewObject(false), m_dbGuid(0)
 
     m_inWorld           = false;
     m_objectUpdated     = false;
+    m_clientUpdateSlot  = CLIENT_UPDATE_SLOT_NONE;
     m_loot              = nullptr;
 }
 
@@ -207,14 +208,120 @@ void Object::SendCreateUpdateToPlayer(Player* player) const
     }
 }
 
-void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target) const
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target, UpdateBlockCache* cache) const
 {
+    if (!cache)
+    {
+        UpdateMask updateMask;
+        updateMask.SetCount(m_valuesCount);
+
+        _SetUpdateBits(updateMask, target);
+        if (updateMask.HasData())
+            BuildValuesUpdateBlockForPlayer(data, updateMask, target);
+        return;
+    }
+
+    if (!cache->m_initialized)
+        InitUpdateBlockCache(*cache);
+
+    uint16 const* flags = nullptr;
+    uint16 visibleFlag = GetUpdateFieldFlagsForTarget(target, flags);
+    MANGOS_ASSERT(flags);
+
+    uint32 cacheKey = 0;
+    if (cache->m_cacheable)
+    {
+        cacheKey = GetUpdateBlockCacheKey(*cache, visibleFlag, target);
+        if (ByteBuffer const* block = cache->Find(cacheKey))
+        {
+            if (block->size())
+                data.AddUpdateBlock(*block);
+            return;
+        }
+    }
+
     UpdateMask updateMask;
     updateMask.SetCount(m_valuesCount);
 
-    _SetUpdateBits(updateMask, target);
+    for (uint16 index = 0; index < m_valuesCount; ++index)
+        if (m_changedValues[index] && (flags[index] & visibleFlag))
+            updateMask.SetBit(index);
+
+    ByteBuffer buf(0);
     if (updateMask.HasData())
-        BuildValuesUpdateBlockForPlayer(data, updateMask, target);
+    {
+        buf.reserve(500);
+        buf << uint8(UPDATETYPE_VALUES);
+        buf << GetPackGUID();
+
+        BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+        data.AddUpdateBlock(buf);
+    }
+
+    if (cache->m_cacheable)
+        cache->Store(cacheKey, std::move(buf));
+}
+
+void Object::InitUpdateBlockCache(UpdateBlockCache& cache) const
+{
+    cache.m_initialized = true;
+    cache.m_cacheable = true;
+
+    switch (GetTypeId())
+    {
+        case TYPEID_UNIT:
+        case TYPEID_PLAYER:
+            // added to every values update and altered for the caster
+            if (static_cast<Unit const*>(this)->HasAuraState(AURA_STATE_CONFLAGRATE))
+            {
+                cache.m_cacheable = false;
+                return;
+            }
+
+            if (m_changedValues[UNIT_DYNAMIC_FLAGS] || m_changedValues[UNIT_FIELD_AURASTATE] ||
+                (GetTypeId() == TYPEID_UNIT && m_changedValues[UNIT_NPC_FLAGS]) ||
+                (GetTypeId() == TYPEID_PLAYER && m_changedValues[UNIT_FIELD_FACTIONTEMPLATE]))
+            {
+                cache.m_cacheable = false;
+                return;
+            }
+
+            cache.m_keyHealth = m_changedValues[UNIT_FIELD_HEALTH] || m_changedValues[UNIT_FIELD_MAXHEALTH];
+            cache.m_keyFlags = m_changedValues[UNIT_FIELD_FLAGS];
+            break;
+        case TYPEID_GAMEOBJECT:
+            // dynamic field is added to every values update and depends on the quests of the receiver
+            if (!static_cast<GameObject const*>(this)->IsDynTransport())
+                cache.m_cacheable = false;
+            break;
+        case TYPEID_CORPSE:
+            if (m_changedValues[CORPSE_FIELD_BYTES_1])
+                cache.m_cacheable = false;
+            break;
+        default:
+            break;
+    }
+}
+
+// must cover every per receiver decision of BuildValuesUpdate for the fields allowed by InitUpdateBlockCache
+uint32 Object::GetUpdateBlockCacheKey(UpdateBlockCache const& cache, uint16 visibleFlag, Player* target) const
+{
+    uint32 key = visibleFlag;
+
+    if (cache.m_keyHealth)
+    {
+        Unit const* unit = static_cast<Unit const*>(this);
+        if (!unit->IsFogOfWarVisibleHealth(target) && !target->CanSeeSpecialInfoOf(unit))
+            key |= 1 << 16;
+    }
+
+    if (cache.m_keyFlags)
+    {
+        if (target->IsGameMaster())
+            key |= 1 << 17;
+    }
+
+    return key;
 }
 
 void Object::BuildValuesUpdateBlockForPlayerWithFlags(UpdateData& data, Player* target, UpdateFieldFlags flags) const
@@ -1235,7 +1342,7 @@ bool Object::PrintEntryError(char const* descr) const
     return false;
 }
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, UpdateBlockCache* cache) const
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -1246,7 +1353,7 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(iter->second, iter->first);
+    BuildValuesUpdateBlockForPlayer(iter->second, iter->first, cache);
 }
 
 void Object::AddToClientUpdateList()
@@ -2661,6 +2768,7 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
+    UpdateBlockCache i_blockCache;
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj)
     {
         // send self fields changes in another way, otherwise
@@ -2675,7 +2783,7 @@ struct WorldObjectChangeAccumulator
         {
             Player* owner = iter.getSource()->GetOwner();
             if (owner != &i_object && owner->HasAtClient(&i_object))
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, &i_blockCache);
         }
     }
 
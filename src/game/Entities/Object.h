@@ -122,6 +122,9 @@ class GenericTransport;
 
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 
+// object is not in the client update list of its map
+static const uint32 CLIENT_UPDATE_SLOT_NONE = 0xFFFFFFFF;
+
 // Spell cooldown flags sent in SMSG_SPELL_COOLDOWN
 enum SpellCooldownFlags
 {
@@ -437,7 +440,7 @@ class Object
         void MarkForClientUpdate();
         void SendForcedObjectUpdate();
 
-        void BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target, UpdateBlockCache* cache = nullptr) const;
         void BuildValuesUpdateBlockForPlayerWithFlags(UpdateData& data, Player* target, UpdateFieldFlags flags) const;
         void BuildValuesUpdateBlockForPlayer(UpdateData& data, UpdateMask& updateMask, Player* target) const;
         void BuildForcedValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
@@ -632,6 +635,10 @@ class Object
         virtual bool HasInvolvedQuest(uint32 /* quest_id */) const { return false; }
         void SetItsNewObject(bool enable) { m_itsNewObject = enable; }
 
+        // index in the client update list of the map, maintained by Map::AddUpdateObject/RemoveUpdateObject
+        uint32 GetClientUpdateSlot() const { return m_clientUpdateSlot; }
+        void SetClientUpdateSlot(uint32 slot) { m_clientUpdateSlot = slot; }
+
         Loot* m_loot;
 
         inline bool IsPlayer() const { return GetTypeId() == TYPEID_PLAYER; }
@@ -652,7 +659,9 @@ class Object
 
         void BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const;
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const;
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, UpdateBlockCache* cache = nullptr) const;
+        void InitUpdateBlockCache(UpdateBlockCache& cache) const;
+        uint32 GetUpdateBlockCacheKey(UpdateBlockCache const& cache, uint16 visibleFlag, Player* target) const;
 
         uint16 m_objectType;
 
@@ -671,6 +680,7 @@ class Object
         uint16 m_valuesCount;
 
         bool m_objectUpdated;
+        uint32 m_clientUpdateSlot;
 
     private:
         bool m_inWorld;
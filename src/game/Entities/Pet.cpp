@@ -2450,7 +2450,7 @@ void Pet::ForcedDespawn(uint32 timeMSToDespawn, bool onlyAlive)
         }
 
         if (InstanceData* mapInstance = GetInstanceData())
-            mapInstance->OnCreatureDespawn(this);
+            GetMap()->ExecuteSerialized([mapInstance, this](Map*) { mapInstance->OnCreatureDespawn(this); });
     }
 
     Unsummon(PET_SAVE_NOT_IN_SLOT, owner);
@@ -70,6 +70,10 @@
 #include "World/WorldState.h"
 #include "Anticheat/Anticheat.hpp"
 
+#ifdef BUILD_METRICS
+ #include "Metric/Metric.h"
+#endif
+
 #ifdef BUILD_DEPRECATED_PLAYERBOT
 #include "PlayerBot/Base/PlayerbotAI.h"
 #include "PlayerBot/Base/PlayerbotMgr.h"
@@ -697,6 +701,12 @@ Player::Player(WorldSession* session): Unit(), m_taxiTracker(*this), m_mover(thi
 
     m_fishingSteps = 0;
 
+    m_saveRowCount = 0;
+    m_saveSkippedRowCount = 0;
+    m_savedAurasChecksum = 0;
+    m_savedCooldownsChecksum = 0;
+    m_saveFailedTransactions = 0;
+
     m_lastDbGuid = 0;
     m_lastGameObject = false;
 }
@@ -4086,12 +4096,9 @@ void Player::_LoadSpellCooldowns(std::unique_ptr<QueryResult> queryResult)
 void Player::_SaveSpellCooldowns()
 {
     static SqlStatementID deleteSpellCooldown;
+    static SqlBatchStatementID insertSpellCooldown;
 
-    // delete all old cooldown
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
-    static SqlStatementID insertSpellCooldown;
+    SqlBatchInsert stmt(CharacterDatabase, insertSpellCooldown, "character_spell_cooldown", "guid, SpellId, SpellExpireTime, Category, CategoryExpireTime, ItemId");
 
     for (auto& cdItr : m_cooldownMap)
     {
@@ -4105,16 +4112,28 @@ void Player::_SaveSpellCooldowns()
             uint64 spellExpireTime = uint64(Clock::to_time_t(sTime));
             uint64 catExpireTime = uint64(Clock::to_time_t(cTime));
 
-            stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO character_spell_cooldown (guid, SpellId, SpellExpireTime, Category, CategoryExpireTime, ItemId) VALUES( ?, ?, ?, ?, ?, ?)");
             stmt.addUInt32(GetGUIDLow());
             stmt.addUInt32(cdData->GetSpellId());
             stmt.addUInt64(spellExpireTime);
             stmt.addUInt32(cdData->GetCategory());
             stmt.addUInt64(catExpireTime);
             stmt.addUInt32(cdData->GetItemId());
-            stmt.Execute();
         }
     }
+
+    // expire times are absolute, so without new cooldowns the rows are the ones already stored
+    if (stmt.GetChecksum() == m_savedCooldownsChecksum)
+    {
+        m_saveSkippedRowCount += stmt.GetRowCount();
+        return;
+    }
+
+    // delete all old cooldown
+    SqlStatement stmtDel = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ?");
+    stmtDel.PExecute(GetGUIDLow());
+
+    m_savedCooldownsChecksum = stmt.GetChecksum();
+    m_saveRowCount += stmt.Execute();
 }
 
 uint32 Player::resetTalentsCost() const
@@ -18120,6 +18139,9 @@ bool Player::_LoadHomeBind(std::unique_ptr<QueryResult> queryResult)
 
 void Player::SaveToDB()
 {
+    // autosaves run on the map thread, route them like the requests of the session
+    SqlOwnerScope ownerScope(GetSession()->GetAccountId());
+
     // we should assure this: ASSERT((m_nextSave != sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE)));
     // delay auto save at any saves (manual, in code, or autosave)
     m_nextSave = sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE);
@@ -18137,30 +18159,32 @@ void Player::SaveToDB()
     DEBUG_FILTER_LOG(LOG_FILTER_PLAYER_STATS, "The value of player %s at save: ", m_name.c_str());
     outDebugStatsValues();
 
-    CharacterDatabase.BeginTransaction();
+    std::chrono::steady_clock::time_point saveStart = std::chrono::steady_clock::now();
+    m_saveRowCount = 0;
+    m_saveSkippedRowCount = 0;
 
-    static SqlStatementID delChar ;
-    static SqlStatementID insChar ;
+    // the checksums are set when the rows are queued, a failed transaction since then may have lost them
+    uint32 failedTransactions = CharacterDatabase.GetFailedTransactionCount();
+    if (failedTransactions != m_saveFailedTransactions)
+    {
+        m_savedAurasChecksum = 0;
+        m_savedCooldownsChecksum = 0;
+        m_saveFailedTransactions = failedTransactions;
+    }
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delChar, "DELETE FROM characters WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
+    CharacterDatabase.BeginTransaction();
+
+    static SqlBatchStatementID insChar;
 
-    SqlStatement uberInsert = CharacterDatabase.CreateStatement(insChar, "INSERT INTO characters (guid,account,name,race,class,gender,level,xp,money,playerBytes,playerBytes2,playerFlags,"
+    // updated in place, the row is never deleted and inserted again
+    SqlBatchInsert uberInsert(CharacterDatabase, insChar, "characters", "guid,account,name,race,class,gender,level,xp,money,playerBytes,playerBytes2,playerFlags,"
                               "map, dungeon_difficulty, position_x, position_y, position_z, orientation, "
                               "taximask, online, cinematic, "
                               "totaltime, leveltime, rest_bonus, logout_time, is_logout_resting, resettalents_cost, resettalents_time, "
                               "trans_x, trans_y, trans_z, trans_o, transguid, extra_flags, stable_slots, at_login, zone, "
                               "death_expire_time, taxi_path, arenaPoints, totalHonorPoints, todayHonorPoints, yesterdayHonorPoints, totalKills, "
                               "todayKills, yesterdayKills, chosenTitle, knownCurrencies, watchedFaction, drunk, health, power1, power2, power3, "
-                              "power4, power5, power6, power7, specCount, activeSpec, exploredZones, equipmentCache, ammoId, knownTitles, actionBars, grantableLevels, fishingSteps) "
-                              "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?) ");
+                              "power4, power5, power6, power7, specCount, activeSpec, exploredZones, equipmentCache, ammoId, knownTitles, actionBars, grantableLevels, fishingSteps", "guid");
 
     uberInsert.addUInt32(GetGUIDLow());
     uberInsert.addUInt32(GetSession()->GetAccountId());
@@ -18300,7 +18324,7 @@ void Player::SaveToDB()
 
     uberInsert.addUInt8(m_fishingSteps);
 
-    uberInsert.Execute();
+    m_saveRowCount += uberInsert.Execute();
 
     if (m_mailsUpdated)                                     // save mails only when needed
         _SaveMail();
@@ -18326,6 +18350,16 @@ void Player::SaveToDB()
 
     CharacterDatabase.CommitTransaction();
 
+    uint64 saveTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - saveStart).count();
+    DEBUG_LOG("Player::SaveToDB: %s saved in " UI64FMTD " us, %u rows written, %u unchanged rows skipped", GetGuidStr().c_str(), saveTime, m_saveRowCount, m_saveSkippedRowCount);
+
+#ifdef BUILD_METRICS
+    metric::measurement meas("player.save");
+    meas.add_field("duration_us", std::to_string(saveTime));
+    meas.add_field("rows", std::to_string(m_saveRowCount));
+    meas.add_field("skipped_rows", std::to_string(m_saveSkippedRowCount));
+#endif
+
     // check if stats should only be saved on logout
     // save stats can be out of transaction
     if (m_session->isLogingOut() || !sWorld.getConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT))
@@ -18410,20 +18444,13 @@ void Player::_SaveActions()
 void Player::_SaveAuras()
 {
     static SqlStatementID deleteAuras ;
-    static SqlStatementID insertAuras ;
+    static SqlBatchStatementID insertAuras ;
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
+    SqlBatchInsert stmt(CharacterDatabase, insertAuras, "character_aura", "guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
+                        "basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask");
 
     SpellAuraHolderMap const& auraHolders = GetSpellAuraHolderMap();
 
-    if (auraHolders.empty())
-        return;
-
-    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO character_aura (guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
-            "basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask) "
-            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
-
     for (const auto& auraHolder : auraHolders)
     {
         SpellAuraHolder* holder = auraHolder.second;
@@ -18471,9 +18498,21 @@ void Player::_SaveAuras()
             stmt.addInt32(holder->GetAuraMaxDuration());
             stmt.addInt32(holder->GetAuraDuration());
             stmt.addUInt32(effIndexMask);
-            stmt.Execute();
         }
     }
+
+    // same rows as written by the last save (no auras or only permanent ones)
+    if (stmt.GetChecksum() == m_savedAurasChecksum)
+    {
+        m_saveSkippedRowCount += stmt.GetRowCount();
+        return;
+    }
+
+    SqlStatement stmtDel = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
+    stmtDel.PExecute(GetGUIDLow());
+
+    m_savedAurasChecksum = stmt.GetChecksum();
+    m_saveRowCount += stmt.Execute();
 }
 
 void Player::_SaveGlyphs()
@@ -18652,9 +18691,11 @@ void Player::_SaveMail()
 
 void Player::_SaveQuestStatus()
 {
-    static SqlStatementID insertQuestStatus ;
+    static SqlBatchStatementID insertQuestStatus ;
 
-    static SqlStatementID updateQuestStatus ;
+    // new and changed quests are written the same way, existing rows are updated
+    SqlBatchInsert stmt(CharacterDatabase, insertQuestStatus, "character_queststatus", "guid,quest,status,rewarded,explored,timer,mobcount1,mobcount2,mobcount3,mobcount4,"
+                        "itemcount1,itemcount2,itemcount3,itemcount4,itemcount5,itemcount6", "guid,quest");
 
     // we don't need transactions here.
     for (auto& mQuestStatu : mQuestStatus)
@@ -18663,14 +18704,12 @@ void Player::_SaveQuestStatus()
         switch (questStatus.uState)
         {
             case QUEST_NEW :
+            case QUEST_CHANGED :
             {
                 Quest const* quest = sObjectMgr.GetQuestTemplate(mQuestStatu.first);
                 if (quest->IsAutoComplete() && !questStatus.m_rewarded)
                     continue;
 
-                SqlStatement stmt = CharacterDatabase.CreateStatement(insertQuestStatus, "INSERT INTO character_queststatus (guid,quest,status,rewarded,explored,timer,mobcount1,mobcount2,mobcount3,mobcount4,itemcount1,itemcount2,itemcount3,itemcount4,itemcount5,itemcount6) "
-                                    "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
-
                 stmt.addUInt32(GetGUIDLow());
                 stmt.addUInt32(mQuestStatu.first);
                 stmt.addUInt8(questStatus.m_status);
@@ -18681,29 +18720,6 @@ void Player::_SaveQuestStatus()
                     stmt.addUInt32(k);
                 for (unsigned int k : questStatus.m_itemcount)
                     stmt.addUInt32(k);
-                stmt.Execute();
-            }
-            break;
-            case QUEST_CHANGED :
-            {
-                Quest const* quest = sObjectMgr.GetQuestTemplate(mQuestStatu.first);
-                if (quest->IsAutoComplete() && !questStatus.m_rewarded)
-                    continue;
-
-                SqlStatement stmt = CharacterDatabase.CreateStatement(updateQuestStatus, "UPDATE character_queststatus SET status = ?,rewarded = ?,explored = ?,timer = ?,"
-                                    "mobcount1 = ?,mobcount2 = ?,mobcount3 = ?,mobcount4 = ?,itemcount1 = ?,itemcount2 = ?,itemcount3 = ?,itemcount4 = ?,itemcount5 = ?,itemcount6 = ? WHERE guid = ? AND quest = ?");
-
-                stmt.addUInt8(questStatus.m_status);
-                stmt.addUInt8(questStatus.m_rewarded);
-                stmt.addUInt8(questStatus.m_explored);
-                stmt.addUInt64(uint64(questStatus.m_timer / IN_MILLISECONDS + sWorld.GetGameTime()));
-                for (unsigned int k : questStatus.m_creatureOrGOcount)
-                    stmt.addUInt32(k);
-                for (unsigned int k : questStatus.m_itemcount)
-                    stmt.addUInt32(k);
-                stmt.addUInt32(GetGUIDLow());
-                stmt.addUInt32(mQuestStatu.first);
-                stmt.Execute();
             }
             break;
             case QUEST_UNCHANGED:
@@ -18711,6 +18727,8 @@ void Player::_SaveQuestStatus()
         }
         questStatus.uState = QUEST_UNCHANGED;
     }
+
+    m_saveRowCount += stmt.Execute();
 }
 
 void Player::_SaveDailyQuestStatus()
@@ -18785,8 +18803,9 @@ void Player::_SaveMonthlyQuestStatus()
 void Player::_SaveSkills()
 {
     static SqlStatementID delSkills ;
-    static SqlStatementID insSkills ;
-    static SqlStatementID updSkills ;
+    static SqlBatchStatementID insSkills ;
+
+    SqlBatchInsert stmtIns(CharacterDatabase, insSkills, "character_skills", "guid, skill, value, max", "guid, skill");
 
     // we don't need transactions here.
     for (SkillStatusMap::iterator itr = mSkillStatus.begin(); itr != mSkillStatus.end();)
@@ -18812,17 +18831,9 @@ void Player::_SaveSkills()
         switch (itr->second.uState)
         {
             case SKILL_NEW:
-            {
-                SqlStatement stmt = CharacterDatabase.CreateStatement(insSkills, "INSERT INTO character_skills (guid, skill, value, max) VALUES (?, ?, ?, ?)");
-                stmt.PExecute(GetGUIDLow(), itr->first, value, max);
-            }
-            break;
             case SKILL_CHANGED:
-            {
-                SqlStatement stmt = CharacterDatabase.CreateStatement(updSkills, "UPDATE character_skills SET value = ?, max = ? WHERE guid = ? AND skill = ?");
-                stmt.PExecute(value, max, GetGUIDLow(), itr->first);
-            }
-            break;
+                stmtIns.addUInt32(GetGUIDLow()).addUInt32(itr->first).addUInt16(value).addUInt16(max);
+                break;
             case SKILL_UNCHANGED:
             case SKILL_DELETED:
                 MANGOS_ASSERT(false);
@@ -18832,15 +18843,17 @@ void Player::_SaveSkills()
 
         ++itr;
     }
+
+    m_saveRowCount += stmtIns.Execute();
 }
 
 void Player::_SaveSpells()
 {
     static SqlStatementID delSpells ;
-    static SqlStatementID insSpells ;
+    static SqlBatchStatementID insSpells ;
 
     SqlStatement stmtDel = CharacterDatabase.CreateStatement(delSpells, "DELETE FROM character_spell WHERE guid = ? and spell = ?");
-    SqlStatement stmtIns = CharacterDatabase.CreateStatement(insSpells, "INSERT INTO character_spell (guid,spell,active,disabled) VALUES (?, ?, ?, ?)");
+    SqlBatchInsert stmtIns(CharacterDatabase, insSpells, "character_spell", "guid,spell,active,disabled", "guid,spell");
 
     for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
     {
@@ -18849,12 +18862,11 @@ void Player::_SaveSpells()
 
         if (!talentCosts)
         {
-            if (playerSpell.state == PLAYERSPELL_REMOVED || playerSpell.state == PLAYERSPELL_CHANGED)
+            // add only changed/new not dependent spells, changed ones replace their row
+            if (playerSpell.state == PLAYERSPELL_REMOVED || (playerSpell.state == PLAYERSPELL_CHANGED && playerSpell.dependent))
                 stmtDel.PExecute(GetGUIDLow(), itr->first);
-
-            // add only changed/new not dependent spells
-            if (!playerSpell.dependent && (playerSpell.state == PLAYERSPELL_NEW || playerSpell.state == PLAYERSPELL_CHANGED))
-                stmtIns.PExecute(GetGUIDLow(), itr->first, uint8(playerSpell.active ? 1 : 0), uint8(playerSpell.disabled ? 1 : 0));
+            else if (!playerSpell.dependent && (playerSpell.state == PLAYERSPELL_NEW || playerSpell.state == PLAYERSPELL_CHANGED))
+                stmtIns.addUInt32(GetGUIDLow()).addUInt32(itr->first).addUInt8(playerSpell.active ? 1 : 0).addUInt8(playerSpell.disabled ? 1 : 0);
         }
 
         if (playerSpell.state == PLAYERSPELL_REMOVED)
@@ -18865,27 +18877,29 @@ void Player::_SaveSpells()
             ++itr;
         }
     }
+
+    m_saveRowCount += stmtIns.Execute();
 }
 
 void Player::_SaveTalents()
 {
     static SqlStatementID delTalents ;
-    static SqlStatementID insTalents ;
+    static SqlBatchStatementID insTalents ;
 
     SqlStatement stmtDel = CharacterDatabase.CreateStatement(delTalents, "DELETE FROM character_talent WHERE guid = ? and talent_id = ? and spec = ?");
-    SqlStatement stmtIns = CharacterDatabase.CreateStatement(insTalents, "INSERT INTO character_talent (guid, talent_id, current_rank , spec) VALUES (?, ?, ?, ?)");
+    SqlBatchInsert stmtIns(CharacterDatabase, insTalents, "character_talent", "guid, talent_id, current_rank, spec", "guid, talent_id, spec");
 
     for (uint32 i = 0; i < MAX_TALENT_SPEC_COUNT; ++i)
     {
         for (PlayerTalentMap::iterator itr = m_talents[i].begin(); itr != m_talents[i].end();)
         {
             PlayerTalent& playerTalent = itr->second;
-            if (playerTalent.state == PLAYERSPELL_REMOVED || playerTalent.state == PLAYERSPELL_CHANGED)
+            if (playerTalent.state == PLAYERSPELL_REMOVED)
                 stmtDel.PExecute(GetGUIDLow(), itr->first, i);
 
-            // add only changed/new talents
+            // add only changed/new talents, changed ones replace their row
             if (playerTalent.state == PLAYERSPELL_NEW || playerTalent.state == PLAYERSPELL_CHANGED)
-                stmtIns.PExecute(GetGUIDLow(), itr->first, playerTalent.currentRank, i);
+                stmtIns.addUInt32(GetGUIDLow()).addUInt32(itr->first).addUInt32(playerTalent.currentRank).addUInt32(i);
 
             if (playerTalent.state == PLAYERSPELL_REMOVED)
                 m_talents[i].erase(itr++);
@@ -18896,6 +18910,8 @@ void Player::_SaveTalents()
             }
         }
     }
+
+    m_saveRowCount += stmtIns.Execute();
 }
 
 // save player stats -- only for external usage
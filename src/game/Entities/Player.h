@@ -2951,6 +2951,13 @@ class Player : public Unit
 
         uint8 m_fishingSteps;
 
+        // statistics of the running save and state of tables written only when their rows changed
+        uint32 m_saveRowCount;
+        uint32 m_saveSkippedRowCount;
+        uint64 m_savedAurasChecksum;
+        uint64 m_savedCooldownsChecksum;
+        uint32 m_saveFailedTransactions;                    // CharacterDatabase failed transaction count seen by the last save
+
         std::map<uint32, ItemSetEffect> m_itemSetEffects;
 
         uint32 m_lastDbGuid; bool m_lastGameObject;
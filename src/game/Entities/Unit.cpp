@@ -292,7 +292,7 @@ Unit::Unit() :
     // m_Aura = nullptr;
     // m_AurasCheck = 2000;
     // m_removeAuraTimer = 4;
-    m_spellAuraHoldersUpdateIterator = m_spellAuraHolders.end();
+    m_spellAuraHoldersUpdateIterator = m_updatedAuraHolders.end();
     m_AuraFlags = 0;
 
     m_Visibility = VISIBILITY_ON;
@@ -544,7 +544,10 @@ void Unit::TriggerEvadeEvents()
     static_cast<Creature*>(this)->SetLootRecipient(nullptr);
 
     if (InstanceData* mapInstance = GetInstanceData())
-        mapInstance->OnCreatureEvade((Creature*)this);
+    {
+        Creature* creature = static_cast<Creature*>(this);
+        GetMap()->ExecuteSerialized([mapInstance, creature](Map*) { mapInstance->OnCreatureEvade(creature); });
+    }
 
     if (m_isCreatureLinkingTrigger)
         GetMap()->GetCreatureLinkingHolder()->DoCreatureLinkingEvent(LINKING_EVENT_EVADE, static_cast<Creature*>(this));
@@ -838,6 +841,9 @@ void Unit::DealDamageMods(Unit* dealer, Unit* victim, uint32& damage, uint32* ab
     if (victim->AI())
         victim->AI()->DamageTaken(dealer, damage, damagetype, spellInfo);
 
+    if (victim->GetTypeId() == TYPEID_UNIT)
+        static_cast<Creature*>(victim)->SetFullUpdateTier();
+
     if (absorb && originalDamage > damage)
         *absorb += (originalDamage - damage);
 }
@@ -1119,10 +1125,11 @@ void Unit::Kill(Unit* killer, Unit* victim, DamageEffectType damagetype, SpellEn
     ProcDamageAndSpell(ProcSystemArguments(victim, victim, PROC_FLAG_NONE, PROC_FLAG_DEATH, PROC_EX_NONE, 0, 0));
 
     // Reward player, his pets, and group/raid members
+    // the group is map wide (members can be in other regions of a parallel update), rewards are handed out serialized
     if (tapper != victim)
     {
         if (tapperGroup)
-            tapperGroup->RewardGroupAtKill(victim, tapper);
+            victim->GetMap()->ExecuteSerialized([tapperGroup, victim, tapper](Map*) { tapperGroup->RewardGroupAtKill(victim, tapper); });
         else if (tapper)
             tapper->RewardSinglePlayerAtKill(victim);
     }
@@ -1419,7 +1426,7 @@ void Unit::JustKilledCreature(Unit* killer, Creature* victim, Player* responsibl
 
     // Inform Instance Data and Linking
     if (InstanceData* mapInstance = victim->GetInstanceData())
-        mapInstance->OnCreatureDeath(victim);
+        victim->GetMap()->ExecuteSerialized([mapInstance, victim](Map*) { mapInstance->OnCreatureDeath(victim); });
 
     if (responsiblePlayer)                                  // killedby Player, inform BG
         if (BattleGround* bg = responsiblePlayer->GetBattleGround())
@@ -4651,29 +4658,34 @@ void Unit::_UpdateSpells(uint32 time)
 
     // update auras
     // m_AurasUpdateIterator can be updated in inderect called code at aura remove to skip next planned to update but removed auras
-    for (m_spellAuraHoldersUpdateIterator = m_spellAuraHolders.begin(); m_spellAuraHoldersUpdateIterator != m_spellAuraHolders.end();)
+    std::vector<SpellAuraHolder*> expiredHolders;
+    for (m_spellAuraHoldersUpdateIterator = m_updatedAuraHolders.begin(); m_spellAuraHoldersUpdateIterator != m_updatedAuraHolders.end();)
     {
-        SpellAuraHolder* i_holder = m_spellAuraHoldersUpdateIterator->second;
+        SpellAuraHolderMap::iterator current = m_spellAuraHoldersUpdateIterator;
+        SpellAuraHolder* i_holder = current->second;
         ++m_spellAuraHoldersUpdateIterator;                 // need shift to next for allow update if need into aura update
         i_holder->UpdateHolder(time);
 #ifdef BUILD_METRICS
         updatedSpellIds.push_back(i_holder->GetId());
 #endif
-    }
-
-    // remove expired auras
-    for (SpellAuraHolderMap::iterator iter = m_spellAuraHolders.begin(); iter != m_spellAuraHolders.end();)
-    {
-        SpellAuraHolder* holder = iter->second;
+        // removed holders already left the update list
+        if (i_holder->IsDeleted())
+            continue;
 
-        if (!(holder->IsPermanent() || holder->IsPassive()) && holder->GetAuraDuration() == 0)
+        if (!(i_holder->IsPermanent() || i_holder->IsPassive()) && i_holder->GetAuraDuration() == 0)
+            expiredHolders.push_back(i_holder);
+        else if (i_holder->IsUpdateIdle())
         {
-            RemoveSpellAuraHolder(holder, AURA_REMOVE_BY_EXPIRE);
-            iter = m_spellAuraHolders.begin();
+            // resumed by duration or periodic changes, see SpellAuraHolder::ResumeUpdate
+            i_holder->SetUpdateSuspended(true);
+            m_updatedAuraHolders.erase(current);
         }
-        else
-            ++iter;
     }
+
+    // remove expired auras, in update order
+    for (SpellAuraHolder* holder : expiredHolders)
+        if (!holder->IsDeleted() && !(holder->IsPermanent() || holder->IsPassive()) && holder->GetAuraDuration() == 0)
+            RemoveSpellAuraHolder(holder, AURA_REMOVE_BY_EXPIRE);
 #ifdef BUILD_METRICS
     std::string logging;
     for (uint32 spellId : updatedSpellIds)
@@ -5463,6 +5475,9 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
     holder->_AddSpellAuraHolder();
     holder->SetCreationDelayFlag();
     m_spellAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
+    m_updatedAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
+    if (uint32 procFlags = sSpellMgr.GetSpellProcFlags(holder->GetSpellProto()))
+        m_procAuraHolders.emplace(holder->GetId(), std::make_pair(procFlags, holder));
 
     for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
@@ -6078,6 +6093,12 @@ void Unit::RemoveNotOwnTrackedTargetAuras(uint32 newPhase)
     }
 }
 
+void Unit::ResumeSpellAuraHolderUpdate(SpellAuraHolder* holder)
+{
+    holder->SetUpdateSuspended(false);
+    m_updatedAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
+}
+
 void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
 {
     MANGOS_ASSERT(!holder->IsDeleted());
@@ -6090,7 +6111,7 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
         if (caster->GetTypeId() == TYPEID_UNIT && ((Creature*)caster)->IsTotem() && ((Totem*)caster)->GetTotemType() == TOTEM_STATUE)
             statue = ((Totem*)caster);
 
-    if (m_spellAuraHoldersUpdateIterator != m_spellAuraHolders.end() && m_spellAuraHoldersUpdateIterator->second == holder)
+    if (m_spellAuraHoldersUpdateIterator != m_updatedAuraHolders.end() && m_spellAuraHoldersUpdateIterator->second == holder)
         ++m_spellAuraHoldersUpdateIterator;
 
     SpellAuraHolderBounds bounds = GetSpellAuraHolderBounds(holder->GetId());
@@ -6103,6 +6124,29 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
         }
     }
 
+    if (!holder->IsUpdateSuspended())
+    {
+        bounds = m_updatedAuraHolders.equal_range(holder->GetId());
+        for (SpellAuraHolderMap::iterator itr = bounds.first; itr != bounds.second; ++itr)
+        {
+            if (itr->second == holder)
+            {
+                m_updatedAuraHolders.erase(itr);
+                break;
+            }
+        }
+    }
+
+    auto procBounds = m_procAuraHolders.equal_range(holder->GetId());
+    for (ProcAuraHolderMap::iterator itr = procBounds.first; itr != procBounds.second; ++itr)
+    {
+        if (itr->second.second == holder)
+        {
+            m_procAuraHolders.erase(itr);
+            break;
+        }
+    }
+
     holder->SetRemoveMode(mode);
 
     uint32 auraFlags = holder->GetAuraFlags();
@@ -8949,6 +8993,9 @@ void Unit::SetInCombatState(bool PvP, Unit* enemy)
     if (PvP || creatureNotInCombat)
         GetCombatManager().TriggerCombatTimer(PvP);
 
+    if (creatureNotInCombat)
+        static_cast<Creature*>(this)->SetFullUpdateTier();
+
     SetFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_IN_COMBAT);
 
     if (HasCharmer() || !GetOwnerGuid().IsEmpty())
@@ -9028,7 +9075,7 @@ void Unit::SetInCombatState(bool PvP, Unit* enemy)
             creature->SetInCombatWithZone();
 
         if (InstanceData* mapInstance = GetInstanceData())
-            mapInstance->OnCreatureEnterCombat(creature);
+            GetMap()->ExecuteSerialized([mapInstance, creature](Map*) { mapInstance->OnCreatureEnterCombat(creature); });
 
         creature->CallAssistance();
 
@@ -11500,7 +11547,7 @@ Unit* Unit::SelectRandomUnfriendlyTarget(Unit* except /*= nullptr*/, float radiu
     UnitList targets;
 
     MaNGOS::AnyUnfriendlyUnitInObjectRangeCheck u_check(this, radius);
-    MaNGOS::UnitListSearcher<MaNGOS::AnyUnfriendlyUnitInObjectRangeCheck> searcher(targets, u_check);
+    MaNGOS::UnitListSearcher<MaNGOS::AnyUnfriendlyUnitInObjectRangeCheck> searcher(targets, u_check, MaNGOS::AreaBounds(this, radius));
     Cell::VisitAllObjects(this, searcher, radius);
 
     // remove current target
@@ -11557,7 +11604,7 @@ Unit* Unit::SelectRandomFriendlyTarget(Unit* except /*= nullptr*/, float radius
     UnitList targets;
 
     MaNGOS::AnySpellAssistableUnitInObjectRangeCheck u_check(this, nullptr, radius);
-    MaNGOS::UnitListSearcher<MaNGOS::AnySpellAssistableUnitInObjectRangeCheck> searcher(targets, u_check);
+    MaNGOS::UnitListSearcher<MaNGOS::AnySpellAssistableUnitInObjectRangeCheck> searcher(targets, u_check, MaNGOS::AreaBounds(this, radius));
 
     Cell::VisitAllObjects(this, searcher, radius);
 
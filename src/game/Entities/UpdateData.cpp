@@ -60,6 +60,32 @@ void UpdateData::AddUpdateBlock(const ByteBuffer& block)
     }
 }
 
+void UpdateData::Merge(UpdateData& other)
+{
+    m_outOfRangeGUIDs.insert(other.m_outOfRangeGUIDs.begin(), other.m_outOfRangeGUIDs.end());
+
+    for (BufferPair& data : other.m_data)
+    {
+        if (data.m_blockCount == 0)
+            continue;
+
+        const size_t existing = (128 + (9 * m_outOfRangeGUIDs.size()) + m_data[m_currentIndex].m_buffer.size());
+
+        if ((existing + data.m_buffer.size()) < MAX_NETCLIENT_PACKET_SIZE || m_data[m_currentIndex].m_blockCount == 0)
+        {
+            m_data[m_currentIndex].m_buffer.append(data.m_buffer);
+            m_data[m_currentIndex].m_blockCount += data.m_blockCount;
+        }
+        else
+        {
+            ++m_currentIndex;
+            m_data.emplace_back(std::move(data));
+        }
+    }
+
+    other.Clear();
+}
+
 void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
 {
     z_stream c_stream;
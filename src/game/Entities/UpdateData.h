@@ -56,6 +56,32 @@ struct BufferPair
     uint32 m_blockCount;
 };
 
+// values update blocks of one object built during a single client update, receivers that see the same
+// fields in the same way (owner, group member, anyone else...) share the serialized block
+class UpdateBlockCache
+{
+    public:
+        UpdateBlockCache() : m_initialized(false), m_cacheable(false), m_keyHealth(false), m_keyFlags(false) {}
+
+        ByteBuffer const* Find(uint32 key) const
+        {
+            for (auto& block : m_blocks)
+                if (block.first == key)
+                    return &block.second;
+            return nullptr;
+        }
+
+        void Store(uint32 key, ByteBuffer&& block) { m_blocks.emplace_back(key, std::move(block)); }
+
+        bool m_initialized;
+        bool m_cacheable;                                   // false when a changed field is altered per receiver
+        bool m_keyHealth;                                   // receivers differ by seeing health as percentage
+        bool m_keyFlags;                                    // receivers differ by being gamemaster
+
+    private:
+        std::vector<std::pair<uint32, ByteBuffer>> m_blocks; // only a handful of keys per object
+};
+
 class UpdateData
 {
     public:
@@ -64,6 +90,7 @@ class UpdateData
         void AddOutOfRangeGUID(GuidSet& guids);
         void AddOutOfRangeGUID(ObjectGuid const& guid);
         void AddUpdateBlock(const ByteBuffer& block);
+        void Merge(UpdateData& other);                  // appends data built separately for the same receiver
         WorldPacket BuildPacket(size_t index); // Copy Elision is a thing
         bool HasData() const { return m_data[0].m_buffer.size() > 0 || !m_outOfRangeGUIDs.empty(); }
         size_t GetPacketCount() const { return m_data.size(); }
@@ -38,66 +38,68 @@ void VisibleChangesNotifier::Visit(CameraMapType& m)
     }
 }
 
+VisibleNotifier::VisibleNotifier(Camera& c) : i_camera(c)
+{
+    // flat copy, std::set is already sorted so lookups can binary search without rebuilding a tree
+    GuidSet const& clientGuids = c.GetOwner()->GetClientGuids();
+    i_clientGUIDs.assign(clientGuids.begin(), clientGuids.end());
+    i_visited.assign(i_clientGUIDs.size(), false);
+}
+
 void VisibleNotifier::Notify()
 {
     Player& player = *i_camera.GetOwner();
-    // at this moment i_clientGUIDs have guids that not iterate at grid level checks
+    // at this moment not visited guids are those that not iterate at grid level checks
     // but exist one case when this possible and object not out of range: transports
     if (GenericTransport* transport = player.GetTransport())
     {
         for (auto itr : transport->GetPassengers())
         {
-            if (i_clientGUIDs.find(itr->GetObjectGuid()) != i_clientGUIDs.end())
+            if (MarkVisited(itr->GetObjectGuid()))
             {
                 // ignore far sight case
                 if (itr->IsPlayer())
                     static_cast<Player*>(itr)->UpdateVisibilityOf(static_cast<Player*>(itr), &player);
                 player.UpdateVisibilityOf(&player, itr, i_data, i_visibleNow);
-                i_clientGUIDs.erase(itr->GetObjectGuid());
             }
         }
     }
 
     // Far objects update on player notify
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
+    for (size_t i = 0; i < i_clientGUIDs.size(); ++i)
     {
-        GuidSet::iterator current = itr++;
-        if (WorldObject* obj = player.GetMap()->GetWorldObject(*current))
+        if (i_visited[i])
+            continue;
+
+        if (WorldObject* obj = player.GetMap()->GetWorldObject(i_clientGUIDs[i]))
         {
             if (!obj->GetVisibilityData().IsVisibilityOverridden())
                 continue;
 
             player.UpdateVisibilityOf(&player, obj);
-            i_clientGUIDs.erase(current);
+            i_visited[i] = true;
         }
     }
 
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
+    // generate outOfRange for not iterate objects
+    for (size_t i = 0; i < i_clientGUIDs.size(); ++i)
     {
-        if ((*itr).IsMOTransport())
-        {
-            itr = i_clientGUIDs.erase(itr);
+        ObjectGuid const& guid = i_clientGUIDs[i];
+        if (i_visited[i] || guid.IsMOTransport())
             continue;
-        }
-        ++itr;
-    }
 
-    // generate outOfRange for not iterate objects
-    i_data.AddOutOfRangeGUID(i_clientGUIDs);
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
-    {
-        if (WorldObject* target = player.GetMap()->GetWorldObject(*itr))
+        i_data.AddOutOfRangeGUID(guid);
+        if (WorldObject* target = player.GetMap()->GetWorldObject(guid))
         {
             if (target->GetTypeId() == TYPEID_UNIT)
                 player.BeforeVisibilityDestroy(static_cast<Creature*>(target));
             player.RemoveAtClient(target);
         }
         else
-            sLog.outCustomLog("Object was %s in current map.", player.GetMap()->m_objRemoveList.find(*itr) == player.GetMap()->m_objRemoveList.end() ? "not found" : "found");
-        
+            sLog.outCustomLog("Object was %s in current map.", player.GetMap()->m_objRemoveList.find(guid) == player.GetMap()->m_objRemoveList.end() ? "not found" : "found");
 
         DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "%s is out of range (no in active cells set) now for %s",
-                         itr->GetString().c_str(), player.GetGuidStr().c_str());
+                         guid.GetString().c_str(), player.GetGuidStr().c_str());
     }
 
     if (i_data.HasData())
@@ -28,6 +28,7 @@
 #include "Entities/Player.h"
 #include "Entities/Unit.h"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 
@@ -37,13 +38,29 @@ namespace MaNGOS
     {
         Camera& i_camera;
         UpdateData i_data;
-        GuidSet i_clientGUIDs;
+        GuidVector i_clientGUIDs;                           // sorted snapshot of the client guids at notifier creation
+        std::vector<bool> i_visited;                        // parallel to i_clientGUIDs
         WorldObjectSet i_visibleNow;
 
-        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->GetClientGuids()) {}
+        explicit VisibleNotifier(Camera& c);
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(CameraMapType& /*m*/) {}
         void Notify(void);
+
+        // returns true if guid was at client and not visited before
+        bool MarkVisited(ObjectGuid const& guid)
+        {
+            GuidVector::const_iterator itr = std::lower_bound(i_clientGUIDs.begin(), i_clientGUIDs.end(), guid);
+            if (itr == i_clientGUIDs.end() || *itr != guid)
+                return false;
+
+            std::vector<bool>::reference visited = i_visited[itr - i_clientGUIDs.begin()];
+            if (visited)
+                return false;
+
+            visited = true;
+            return true;
+        }
     };
 
     struct VisibleChangesNotifier
@@ -181,6 +198,37 @@ namespace MaNGOS
         void VisitHelper(Unit* target);
     };
 
+    // AREA BOUNDS
+
+    // 2d circle an area search is limited to, searchers skip objects outside of it before running the (expensive) check
+    // the combat reach of the tested object is added, so range checks including both combat reaches keep their result
+    // gameobjects measure against their rotated display box instead of a reach, searches around them stay unbounded
+    class AreaBounds
+    {
+        public:
+            AreaBounds() : m_x(0.f), m_y(0.f), m_radius(-1.f) {}            // unbounded
+            AreaBounds(float x, float y, float radius) : m_x(x), m_y(y), m_radius(radius) {}
+            AreaBounds(WorldObject const* center, float radius)
+                : m_x(center->GetPositionX()), m_y(center->GetPositionY()),
+                  m_radius(center->GetTypeId() == TYPEID_GAMEOBJECT ? -1.f : radius + center->GetCombatReach()) {}
+
+            bool IsInBounds(WorldObject const* obj) const
+            {
+                if (m_radius < 0.f)
+                    return true;
+
+                float dx = obj->GetPositionX() - m_x;
+                float dy = obj->GetPositionY() - m_y;
+                float maxDist = m_radius + obj->GetCombatReach();
+                return dx * dx + dy * dy <= maxDist * maxDist;
+            }
+
+        private:
+            float m_x;
+            float m_y;
+            float m_radius;
+    };
+
     // SEARCHERS & LIST SEARCHERS & WORKERS
 
     /* Model Searcher class:
@@ -356,9 +404,10 @@ namespace MaNGOS
         uint32 i_phaseMask;
         Unit*& i_object;
         Check& i_check;
+        AreaBounds i_bounds;
 
-        UnitSearcher(Unit*& result, Check& check)
-            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_object(result), i_check(check) {}
+        UnitSearcher(Unit*& result, Check& check, AreaBounds const& bounds = AreaBounds())
+            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_object(result), i_check(check), i_bounds(bounds) {}
 
         void Visit(CreatureMapType& m);
         void Visit(PlayerMapType& m);
@@ -373,9 +422,10 @@ namespace MaNGOS
         uint32 i_phaseMask;
         Unit*& i_object;
         Check& i_check;
+        AreaBounds i_bounds;
 
-        UnitLastSearcher(Unit*& result, Check& check)
-            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_object(result), i_check(check) {}
+        UnitLastSearcher(Unit*& result, Check& check, AreaBounds const& bounds = AreaBounds())
+            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_object(result), i_check(check), i_bounds(bounds) {}
 
         void Visit(CreatureMapType& m);
         void Visit(PlayerMapType& m);
@@ -390,9 +440,10 @@ namespace MaNGOS
         uint32 i_phaseMask;
         UnitList& i_objects;
         Check& i_check;
+        AreaBounds i_bounds;
 
-        UnitListSearcher(UnitList& objects, Check& check)
-            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_objects(objects), i_check(check) {}
+        UnitListSearcher(UnitList& objects, Check& check, AreaBounds const& bounds = AreaBounds())
+            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_objects(objects), i_check(check), i_bounds(bounds) {}
 
         void Visit(PlayerMapType& m);
         void Visit(CreatureMapType& m);
@@ -408,9 +459,10 @@ namespace MaNGOS
         uint32 i_phaseMask;
         Creature*& i_object;
         Check& i_check;
+        AreaBounds i_bounds;
 
-        CreatureSearcher(Creature*& result, Check& check)
-            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_object(result), i_check(check) {}
+        CreatureSearcher(Creature*& result, Check& check, AreaBounds const& bounds = AreaBounds())
+            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_object(result), i_check(check), i_bounds(bounds) {}
 
         void Visit(CreatureMapType& m);
 
@@ -424,9 +476,10 @@ namespace MaNGOS
         uint32 i_phaseMask;
         Creature*& i_object;
         Check& i_check;
+        AreaBounds i_bounds;
 
-        CreatureLastSearcher(Creature*& result, Check& check)
-            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_object(result), i_check(check) {}
+        CreatureLastSearcher(Creature*& result, Check& check, AreaBounds const& bounds = AreaBounds())
+            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_object(result), i_check(check), i_bounds(bounds) {}
 
         void Visit(CreatureMapType& m);
 
@@ -439,9 +492,10 @@ namespace MaNGOS
         uint32 i_phaseMask;
         CreatureList& i_objects;
         Check& i_check;
+        AreaBounds i_bounds;
 
-        CreatureListSearcher(CreatureList& objects, Check& check)
-            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_objects(objects), i_check(check) {}
+        CreatureListSearcher(CreatureList& objects, Check& check, AreaBounds const& bounds = AreaBounds())
+            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_objects(objects), i_check(check), i_bounds(bounds) {}
 
         void Visit(CreatureMapType& m);
 
@@ -475,9 +529,10 @@ namespace MaNGOS
         uint32 i_phaseMask;
         Player*& i_object;
         Check& i_check;
+        AreaBounds i_bounds;
 
-        PlayerSearcher(Player*& result, Check& check)
-            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_object(result), i_check(check) {}
+        PlayerSearcher(Player*& result, Check& check, AreaBounds const& bounds = AreaBounds())
+            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_object(result), i_check(check), i_bounds(bounds) {}
 
         void Visit(PlayerMapType& m);
 
@@ -490,9 +545,10 @@ namespace MaNGOS
         uint32 i_phaseMask;
         PlayerList& i_objects;
         Check& i_check;
+        AreaBounds i_bounds;
 
-        PlayerListSearcher(PlayerList& objects, Check& check)
-            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_objects(objects), i_check(check) {}
+        PlayerListSearcher(PlayerList& objects, Check& check, AreaBounds const& bounds = AreaBounds())
+            : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_objects(objects), i_check(check), i_bounds(bounds) {}
 
         void Visit(PlayerMapType& m);
 
@@ -35,7 +35,7 @@ inline void MaNGOS::VisibleNotifier::Visit(GridRefManager<T>& m)
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
-        i_clientGUIDs.erase(iter->getSource()->GetObjectGuid());
+        MarkVisited(iter->getSource()->GetObjectGuid());
     }
 }
 
@@ -114,6 +114,8 @@ inline void MaNGOS::PlayerVisitObjectsNotifier::Visit(CreatureMapType& m)
         if (!creature->IsAlive())
             continue;
 
+        creature->UpdateTierOnApproach(&i_player);
+
         UnitVisitObjectsNotifierWorker(creature, &i_player);
 
         if (playerHasAI)
@@ -532,7 +534,7 @@ void MaNGOS::UnitSearcher<Check>::Visit(CreatureMapType& m)
 
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
+        if (!itr->getSource()->InSamePhase(i_phaseMask) || !i_bounds.IsInBounds(itr->getSource()))
             continue;
 
         if (i_check(itr->getSource()))
@@ -552,7 +554,7 @@ void MaNGOS::UnitSearcher<Check>::Visit(PlayerMapType& m)
 
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
+        if (!itr->getSource()->InSamePhase(i_phaseMask) || !i_bounds.IsInBounds(itr->getSource()))
             continue;
 
         if (i_check(itr->getSource()))
@@ -568,7 +570,7 @@ void MaNGOS::UnitLastSearcher<Check>::Visit(CreatureMapType& m)
 {
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
+        if (!itr->getSource()->InSamePhase(i_phaseMask) || !i_bounds.IsInBounds(itr->getSource()))
             continue;
 
         if (i_check(itr->getSource()))
@@ -581,7 +583,7 @@ void MaNGOS::UnitLastSearcher<Check>::Visit(PlayerMapType& m)
 {
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
+        if (!itr->getSource()->InSamePhase(i_phaseMask) || !i_bounds.IsInBounds(itr->getSource()))
             continue;
 
         if (i_check(itr->getSource()))
@@ -593,7 +595,7 @@ template<class Check>
 void MaNGOS::UnitListSearcher<Check>::Visit(PlayerMapType& m)
 {
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
+        if (itr->getSource()->InSamePhase(i_phaseMask) && i_bounds.IsInBounds(itr->getSource()))
             if (i_check(itr->getSource()))
                 i_objects.push_back(itr->getSource());
 }
@@ -602,7 +604,7 @@ template<class Check>
 void MaNGOS::UnitListSearcher<Check>::Visit(CreatureMapType& m)
 {
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
+        if (itr->getSource()->InSamePhase(i_phaseMask) && i_bounds.IsInBounds(itr->getSource()))
             if (i_check(itr->getSource()))
                 i_objects.push_back(itr->getSource());
 }
@@ -618,7 +620,7 @@ void MaNGOS::CreatureSearcher<Check>::Visit(CreatureMapType& m)
 
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
+        if (!itr->getSource()->InSamePhase(i_phaseMask) || !i_bounds.IsInBounds(itr->getSource()))
             continue;
 
         if (i_check(itr->getSource()))
@@ -634,7 +636,7 @@ void MaNGOS::CreatureLastSearcher<Check>::Visit(CreatureMapType& m)
 {
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
+        if (!itr->getSource()->InSamePhase(i_phaseMask) || !i_bounds.IsInBounds(itr->getSource()))
             continue;
 
         if (i_check(itr->getSource()))
@@ -646,7 +648,7 @@ template<class Check>
 void MaNGOS::CreatureListSearcher<Check>::Visit(CreatureMapType& m)
 {
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
+        if (itr->getSource()->InSamePhase(i_phaseMask) && i_bounds.IsInBounds(itr->getSource()))
             if (i_check(itr->getSource()))
                 i_objects.push_back(itr->getSource());
 }
@@ -660,7 +662,7 @@ void MaNGOS::PlayerSearcher<Check>::Visit(PlayerMapType& m)
 
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
+        if (!itr->getSource()->InSamePhase(i_phaseMask) || !i_bounds.IsInBounds(itr->getSource()))
             continue;
 
         if (i_check(itr->getSource()))
@@ -675,7 +677,7 @@ template<class Check>
 void MaNGOS::PlayerListSearcher<Check>::Visit(PlayerMapType& m)
 {
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
+        if (itr->getSource()->InSamePhase(i_phaseMask) && i_bounds.IsInBounds(itr->getSource()))
             if (i_check(itr->getSource()))
                 i_objects.push_back(itr->getSource());
 }
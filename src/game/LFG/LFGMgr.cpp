@@ -765,6 +765,7 @@ void LFGMgr::JoinLfg(Player* player, uint8 roles, LfgDungeonSet& dungeons, std::
         }
         queueData.m_playerInfoPerGuid[player->GetObjectGuid()].m_roles = roles;
         queueData.m_raid = false;
+        queueData.m_team = player->GetTeam();
         // cross node broadcasts
         WorldPacket data = WorldSession::BuildLfgUpdate(LfgUpdateData(LFG_UPDATETYPE_JOIN_QUEUE, dungeons, comment), true);
         grp->BroadcastPacket(data, false);
@@ -778,11 +779,13 @@ void LFGMgr::JoinLfg(Player* player, uint8 roles, LfgDungeonSet& dungeons, std::
         queueData.m_state = LFG_STATE_QUEUED;
         queueData.m_ownerGuid = player->GetObjectGuid();
         queueData.m_joinTime = player->GetMap()->GetCurrentClockTime();
+        queueData.m_queueTime = queueData.m_joinTime;
         queueData.m_dungeons = dungeons;
         queueData.m_randomDungeonId = rDungeonId;
         queueData.m_playerInfoPerGuid[player->GetObjectGuid()].m_roles = roles;
         queueData.m_playerInfoPerGuid[player->GetObjectGuid()].m_level = player->GetLevel();
         queueData.m_raid = false;
+        queueData.m_team = player->GetTeam();
 
         player->GetLfgData().SetState(LFG_STATE_QUEUED);
     }
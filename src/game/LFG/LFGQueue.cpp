@@ -20,17 +20,30 @@
 #include "LFG/LFGMgr.h"
 #include "World/World.h"
 
+#ifdef BUILD_METRICS
+ #include "Metric/Metric.h"
+#endif
+
+static uint32 const LFG_GROUP_SIZE = LFG_TANKS_NEEDED + LFG_HEALERS_NEEDED + LFG_DPS_NEEDED;
+static uint32 const LFG_ROLE_NEEDED[ROLE_INDEX_COUNT] = { LFG_TANKS_NEEDED, LFG_HEALERS_NEEDED, LFG_DPS_NEEDED };
+static uint8 const LFG_ROLE_FOR_INDEX[ROLE_INDEX_COUNT] = { PLAYER_ROLE_TANK, PLAYER_ROLE_HEALER, PLAYER_ROLE_DAMAGE };
+
 void LFGQueue::AddToQueue(LFGQueueData const& data)
 {
     auto result = m_queueData.emplace(data.m_ownerGuid, data);
     LFGQueueData& queueData = result.first->second;
     if (data.m_roleCheckState == LFG_ROLECHECK_INITIALITING)
         queueData.UpdateRoleCheck(queueData.m_leaderGuid, queueData.m_playerInfoPerGuid[queueData.m_leaderGuid].m_roles, false, false);
+
+    if (queueData.GetState() == LFG_STATE_QUEUED)
+        AddToDungeonQueues(queueData);
 }
 
 void LFGQueue::RemoveFromQueue(ObjectGuid owner)
 {
-    m_queueData.erase(owner);
+    auto itr = m_queueData.find(owner);
+    if (itr != m_queueData.end())
+        EraseQueueData(itr);
 }
 
 void LFGQueue::SetPlayerRoles(ObjectGuid group, ObjectGuid player, uint8 roles)
@@ -40,10 +53,231 @@ void LFGQueue::SetPlayerRoles(ObjectGuid group, ObjectGuid player, uint8 roles)
     {
         itr->second.UpdateRoleCheck(player, roles, false, false);
         if (itr->second.GetState() == LFG_STATE_FAILED)
-            m_queueData.erase(itr);
+            EraseQueueData(itr);
+        else if (itr->second.GetState() == LFG_STATE_QUEUED)
+            AddToDungeonQueues(itr->second);
     }
 }
 
+void LFGQueue::ReturnToQueue(LFGQueueData& data)
+{
+    data.SetState(LFG_STATE_QUEUED);
+    AddToDungeonQueues(data);
+}
+
+void LFGQueue::EraseQueueData(LfgQueueDataMap::iterator itr)
+{
+    RemoveFromDungeonQueues(itr->second);
+    m_queueData.erase(itr);
+}
+
+void LFGQueue::AddToDungeonQueues(LFGQueueData& data)
+{
+    if (data.m_inDungeonQueues || data.m_raid)
+        return;
+
+    data.m_inDungeonQueues = true;
+
+    std::pair<TimePoint, ObjectGuid> entry(data.m_queueTime, data.m_ownerGuid);
+    for (uint32 dungeonId : data.m_dungeons)
+    {
+        LfgDungeonQueue& dungeonQueue = m_dungeonQueues[LfgDungeonQueueKey(dungeonId, data.m_team)];
+        if (data.m_playerInfoPerGuid.size() > 1)
+            dungeonQueue.groups.insert(entry);
+        else if (!data.m_playerInfoPerGuid.empty())
+        {
+            uint8 roles = data.m_playerInfoPerGuid.begin()->second.m_roles;
+            for (uint32 i = ROLE_INDEX_TANK; i < ROLE_INDEX_COUNT; ++i)
+                if (roles & LFG_ROLE_FOR_INDEX[i])
+                    dungeonQueue.soloPlayers[i].insert(entry);
+        }
+        dungeonQueue.changed = true;
+    }
+}
+
+void LFGQueue::RemoveFromDungeonQueues(LFGQueueData& data)
+{
+    if (!data.m_inDungeonQueues)
+        return;
+
+    data.m_inDungeonQueues = false;
+
+    std::pair<TimePoint, ObjectGuid> entry(data.m_queueTime, data.m_ownerGuid);
+    for (uint32 dungeonId : data.m_dungeons)
+    {
+        auto itr = m_dungeonQueues.find(LfgDungeonQueueKey(dungeonId, data.m_team));
+        if (itr == m_dungeonQueues.end())
+            continue;
+
+        itr->second.groups.erase(entry);
+        for (auto& soloPlayers : itr->second.soloPlayers)
+            soloPlayers.erase(entry);
+    }
+}
+
+void LFGQueue::MatchDungeonQueue(uint32 dungeonId, LfgDungeonQueue& dungeonQueue)
+{
+    dungeonQueue.changed = false;
+
+    std::vector<LFGQueueData*> entries;
+    LfgPlayerInfoMap roles;
+    while (true)
+    {
+        // oldest groups get the first chance, when the solo players don't complete them try solo players alone
+        if (!FillProposal(dungeonQueue, true, entries, roles) && !FillProposal(dungeonQueue, false, entries, roles))
+            break;
+
+        MakeProposal(dungeonId, entries, roles);
+    }
+}
+
+bool LFGQueue::FillProposal(LfgDungeonQueue const& dungeonQueue, bool withGroups, std::vector<LFGQueueData*>& entries, LfgPlayerInfoMap& roles)
+{
+    entries.clear();
+    roles.clear();
+
+    // roles offered by the taken entries, assigned roles are recalculated from these so flexible players can switch
+    LfgPlayerInfoMap offeredRoles;
+
+    auto tryAdd = [&](ObjectGuid owner) -> bool
+    {
+        auto itr = m_queueData.find(owner);
+        if (itr == m_queueData.end() || itr->second.GetState() != LFG_STATE_QUEUED)
+            return false;
+
+        LFGQueueData& data = itr->second;
+        if (offeredRoles.size() + data.m_playerInfoPerGuid.size() > LFG_GROUP_SIZE)
+            return false;
+
+        LfgPlayerInfoMap merged = offeredRoles;
+        merged.insert(data.m_playerInfoPerGuid.begin(), data.m_playerInfoPerGuid.end());
+
+        LfgPlayerInfoMap assigned = merged;                // CheckGroupRoles reduces the roles to the assigned ones
+        if (!LFGMgr::CheckGroupRoles(assigned))
+            return false;
+
+        offeredRoles.swap(merged);
+        roles.swap(assigned);
+        entries.push_back(&data);
+        return true;
+    };
+
+    if (withGroups)
+    {
+        for (auto const& entry : dungeonQueue.groups)
+        {
+            tryAdd(entry.second);
+            if (roles.size() == LFG_GROUP_SIZE)
+                return true;
+        }
+
+        if (roles.empty())                                  // no group fits, same result as without groups
+            return false;
+    }
+
+    // fill the missing roles with the longest waiting players, scarce roles first
+    for (uint32 i = ROLE_INDEX_TANK; i < ROLE_INDEX_COUNT; ++i)
+    {
+        auto countAssigned = [&]()
+        {
+            uint32 count = 0;
+            for (auto const& playerRoles : roles)
+                if ((playerRoles.second.m_roles & ~PLAYER_ROLE_LEADER) == LFG_ROLE_FOR_INDEX[i])
+                    ++count;
+            return count;
+        };
+
+        for (auto itr = dungeonQueue.soloPlayers[i].begin(); itr != dungeonQueue.soloPlayers[i].end() && countAssigned() < LFG_ROLE_NEEDED[i]; ++itr)
+            if (roles.find(itr->second) == roles.end())
+                tryAdd(itr->second);
+    }
+
+    return roles.size() == LFG_GROUP_SIZE;
+}
+
+void LFGQueue::MakeProposal(uint32 dungeonId, std::vector<LFGQueueData*> const& entries, LfgPlayerInfoMap const& roles)
+{
+    TimePoint now = sWorld.GetCurrentClockTime();
+
+    LfgProposal proposal(dungeonId);
+    proposal.id = m_nextProposalId++;
+    proposal.state = LFG_PROPOSAL_INITIATING;
+    proposal.group = ObjectGuid(); // only filled when already lfg group
+    proposal.leader = entries.front()->m_leaderGuid ? entries.front()->m_leaderGuid : entries.front()->m_ownerGuid;
+    proposal.cancelTime = now + std::chrono::seconds(LFG_TIME_ROLECHECK);
+    proposal.encounters = 0;
+    proposal.isNew = true;
+
+    for (LFGQueueData* data : entries)
+    {
+        RemoveFromDungeonQueues(*data);
+        data->SetState(LFG_STATE_PROPOSAL);
+        proposal.queues.push_back(data->m_ownerGuid);
+
+        for (auto& playerData : data->m_playerInfoPerGuid)
+        {
+            uint8 role = roles.find(playerData.first)->second.m_roles & ~PLAYER_ROLE_LEADER;
+            proposal.players[playerData.first] = LfgProposalPlayer(role, LFG_ANSWER_PENDING, data->m_ownerGuid.IsGroup() ? data->m_ownerGuid : ObjectGuid(), data->m_randomDungeonId);
+        }
+
+#ifdef BUILD_METRICS
+        metric::measurement meas("lfg.match", { { "dungeon", std::to_string(dungeonId) } });
+        meas.add_field("wait_ms", std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(now - data->m_queueTime).count()));
+        meas.add_field("players", std::to_string(data->m_playerInfoPerGuid.size()));
+#endif
+    }
+
+    std::map<ObjectGuid, std::vector<WorldPacket>> personalizedPackets;
+    for (LFGQueueData* data : entries)
+    {
+        WorldPacket proposalBegin = WorldSession::BuildLfgUpdate(LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, data->GetDungeons(), ""), true);
+        for (auto& playerData : data->m_playerInfoPerGuid)
+        {
+            std::vector<WorldPacket>& packets = personalizedPackets[playerData.first];
+            packets.push_back(proposalBegin);
+            packets.emplace_back(WorldSession::BuildLfgUpdateProposal(proposal, data->m_randomDungeonId, playerData.first));
+        }
+    }
+
+    sWorld.GetMessager().AddMessage([personalizedPackets](World* world)
+    {
+        world->BroadcastPersonalized(personalizedPackets);
+    });
+
+    m_proposals[proposal.id] = proposal;
+}
+
+void LFGQueue::SendQueueMetrics()
+{
+#ifdef BUILD_METRICS
+    uint32 queued = 0;
+    uint32 players = 0;
+    uint32 roles[ROLE_INDEX_COUNT] = { 0, 0, 0 };
+    for (auto const& queueData : m_queueData)
+    {
+        if (queueData.second.GetState() != LFG_STATE_QUEUED)
+            continue;
+
+        ++queued;
+        for (auto const& playerData : queueData.second.m_playerInfoPerGuid)
+        {
+            ++players;
+            for (uint32 i = ROLE_INDEX_TANK; i < ROLE_INDEX_COUNT; ++i)
+                if (playerData.second.m_roles & LFG_ROLE_FOR_INDEX[i])
+                    ++roles[i];
+        }
+    }
+
+    metric::measurement meas("lfg.queue");
+    meas.add_field("entries", std::to_string(queued));
+    meas.add_field("players", std::to_string(players));
+    meas.add_field("tanks", std::to_string(roles[ROLE_INDEX_TANK]));
+    meas.add_field("healers", std::to_string(roles[ROLE_INDEX_HEALER]));
+    meas.add_field("dps", std::to_string(roles[ROLE_INDEX_DPS]));
+    meas.add_field("proposals", std::to_string(m_proposals.size()));
+#endif
+}
+
 void LFGQueue::UpdateProposal(ObjectGuid playerGuid, uint32 proposalId, bool accept)
 {
     auto itr = m_proposals.find(proposalId); // protection against packet spamming
@@ -95,13 +329,12 @@ void LFGQueue::OnPlayerLogout(ObjectGuid guid, ObjectGuid groupGuid)
                 world->BroadcastPersonalized(personalizedPackets);
             });
         }
-        m_queueData.erase(itr);
+        EraseQueueData(itr);
     }
 }
 
 void LFGQueue::Update()
 {
-    uint32 counter = 1;
     while (!World::IsStopped())
     {
         GetMessager().Execute(this);
@@ -113,6 +346,7 @@ void LFGQueue::Update()
             if (queueData.m_roleCheckState == LFG_ROLECHECK_INITIALITING && queueData.m_cancelTime < now)
             {
                 queueData.UpdateRoleCheck(ObjectGuid(), 0, true, true);
+                RemoveFromDungeonQueues(queueData);
                 itr = m_queueData.erase(itr);
             }
             else
@@ -127,7 +361,8 @@ void LFGQueue::Update()
                 if (queueData.GetState() == LFG_STATE_QUEUED)
                 {
                     LfgProposal proposal;
-                    proposal.id = counter++;
+                    proposal.id = m_nextProposalId++;
+                    RemoveFromDungeonQueues(queueData);
                     queueData.PopQueue(proposal);
                     m_proposals[proposal.id] = proposal;
                 }
@@ -135,19 +370,10 @@ void LFGQueue::Update()
         }
         else
         {
-            // no actual matchmaking for now - enable entering for full groups - TODO: matchmaking
-            for (auto& queuedGroupData : m_queueData)
-            {
-                LFGQueueData& queueData = queuedGroupData.second;
-                // rolecheck makes sure integrity of correct group is held
-                if (queueData.GetState() == LFG_STATE_QUEUED && queueData.m_playerInfoPerGuid.size() == 5)
-                {
-                    LfgProposal proposal;
-                    proposal.id = counter++;
-                    queueData.PopQueue(proposal);
-                    m_proposals[proposal.id] = proposal;
-                }
-            }
+            // only dungeons that got new entries since the last pass can produce a new proposal
+            for (auto& dungeonQueue : m_dungeonQueues)
+                if (dungeonQueue.second.changed)
+                    MatchDungeonQueue(dungeonQueue.first.first, dungeonQueue.second);
         }
 
         for (auto& proposalData : m_proposals)
@@ -156,13 +382,23 @@ void LFGQueue::Update()
         for (auto itr = m_queueData.begin(); itr != m_queueData.end();)
         {
             if (itr->second.GetState() == LFG_STATE_FAILED)
+            {
+                RemoveFromDungeonQueues(itr->second);
                 itr = m_queueData.erase(itr);
+            }
             else
                 ++itr;
         }
 
         for (uint32 proposalId : m_proposalsForRemoval)
             m_proposals.erase(proposalId);
+        m_proposalsForRemoval.clear();
+
+        if (now >= m_nextMetricsTime)
+        {
+            SendQueueMetrics();
+            m_nextMetricsTime = now + std::chrono::seconds(10);
+        }
 
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
     }
@@ -392,7 +628,7 @@ void LfgProposal::FailProposal(LFGQueue& queue)
         else
         {
             // continue being queued - did nothing wrong
-            queueData.SetState(LFG_STATE_QUEUED);
+            queue.ReturnToQueue(queueData);
         }
     }
 
@@ -25,6 +25,7 @@
 #include "Server/WorldPacket.h"
 
 #include <string>
+#include <set>
 
 class World;
 class LFGQueue;
@@ -95,8 +96,9 @@ struct LFGQueueData
     bool m_raid;
     uint32 m_team;
     std::string m_comment;
+    bool m_inDungeonQueues; // waiting in the matchmaking buckets of its dungeons
 
-    LFGQueueData() { memset(m_roles, 0, sizeof(m_roles)); }
+    LFGQueueData() : m_team(0), m_inDungeonQueues(false) { memset(m_roles, 0, sizeof(m_roles)); }
 
     void RecalculateRoles();
     void UpdateRoleCheck(ObjectGuid guid, uint8 roles, bool abort, bool timeout);
@@ -107,6 +109,18 @@ struct LFGQueueData
     TimePoint GetJoinTime() const { return m_joinTime; }
 };
 
+// queued entries of one dungeon, bucketed for matchmaking - kept up to date as entries join and leave the queue
+struct LfgDungeonQueue
+{
+    typedef std::set<std::pair<TimePoint, ObjectGuid>> EntrySet; // oldest first
+
+    LfgDungeonQueue() : changed(false) {}
+
+    EntrySet soloPlayers[ROLE_INDEX_COUNT];                // single players by offered role, flexible players are in several buckets
+    EntrySet groups;                                       // partial and full groups
+    bool changed;                                          // entries were added since the last matchmaking pass
+};
+
 /*
  * intended to live in its own thread - must not access anything from the outside that is mutable
  * prototyping for being able to separate certain processes from world thread context entirely
@@ -140,9 +154,26 @@ class LFGQueue
         void UpdateWaitTimeHealer(int32 time, uint32 dungeonId);
         void UpdateWaitTimeTank(int32 time, uint32 dungeonId);
         void UpdateWaitTimeAvg(int32 time, uint32 dungeonId);
-    private:
 
-        std::map<ObjectGuid, LFGQueueData> m_queueData;
+        // puts an entry back into matchmaking after a failed proposal it was not responsible for
+        void ReturnToQueue(LFGQueueData& data);
+    private:
+        typedef std::map<ObjectGuid, LFGQueueData> LfgQueueDataMap;
+        typedef std::pair<uint32, uint32> LfgDungeonQueueKey; // dungeon id, team
+
+        void EraseQueueData(LfgQueueDataMap::iterator itr);
+        void AddToDungeonQueues(LFGQueueData& data);
+        void RemoveFromDungeonQueues(LFGQueueData& data);
+
+        void MatchDungeonQueue(uint32 dungeonId, LfgDungeonQueue& dungeonQueue);
+        bool FillProposal(LfgDungeonQueue const& dungeonQueue, bool withGroups, std::vector<LFGQueueData*>& entries, LfgPlayerInfoMap& roles);
+        void MakeProposal(uint32 dungeonId, std::vector<LFGQueueData*> const& entries, LfgPlayerInfoMap const& roles);
+        void SendQueueMetrics();
+
+        LfgQueueDataMap m_queueData;
+        std::map<LfgDungeonQueueKey, LfgDungeonQueue> m_dungeonQueues;
+        uint32 m_nextProposalId = 1;
+        TimePoint m_nextMetricsTime;
         std::vector<LFGQueueData*> m_sortedQueue; // sorted by time
 
         Messager<LFGQueue> m_messager;
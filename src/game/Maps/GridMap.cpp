@@ -23,12 +23,16 @@
 #include "Server/DBCEnums.h"
 #include "Server/DBCStores.h"
 #include "Maps/GridMap.h"
+#include "Maps/MapManager.h"
 #include "Vmap/VMapFactory.h"
 #include "MotionGenerators/MoveMap.h"
 #include "World/World.h"
 #include "Policies/Singleton.h"
 #include "Util/Util.h"
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 #include <mutex>
 
 char const* MAP_MAGIC         = "MAPS";
@@ -77,12 +81,73 @@ GridMap::~GridMap()
     unloadData();
 }
 
+// Reads the sections of a .map file either through stdio or from a read-only mapping of the whole file
+class GridMapReader
+{
+    public:
+        explicit GridMapReader(FILE* in) : m_file(in), m_data(nullptr), m_size(0), m_pos(0) {}
+        GridMapReader(uint8 const* data, size_t size) : m_file(nullptr), m_data(data), m_size(size), m_pos(0) {}
+
+        bool Seek(uint32 offset)
+        {
+            if (m_file)
+                return fseek(m_file, offset, SEEK_SET) == 0;
+
+            if (offset > m_size)
+                return false;
+            m_pos = offset;
+            return true;
+        }
+
+        template<typename T>
+        bool Read(T& value) { return ReadRaw(&value, sizeof(T)); }
+
+        // point array straight into the mapping when it is suitably aligned, otherwise copy it to the heap
+        template<typename T>
+        bool ReadArray(T*& data, size_t count)
+        {
+            size_t const bytes = sizeof(T) * count;
+            if (m_data && m_pos + bytes <= m_size && reinterpret_cast<uintptr_t>(m_data + m_pos) % alignof(T) == 0)
+            {
+                data = const_cast<T*>(reinterpret_cast<T const*>(m_data + m_pos));
+                m_pos += bytes;
+                return true;
+            }
+
+            data = new T[count];
+            return ReadRaw(data, bytes);
+        }
+
+    private:
+        bool ReadRaw(void* data, size_t bytes)
+        {
+            if (!bytes)
+                return true;
+
+            if (m_file)
+                return fread(data, bytes, 1, m_file) == 1;
+
+            if (m_pos + bytes > m_size)
+                return false;
+            memcpy(data, m_data + m_pos, bytes);
+            m_pos += bytes;
+            return true;
+        }
+
+        FILE* m_file;
+        uint8 const* m_data;
+        size_t m_size;
+        size_t m_pos;
+};
+
 bool GridMap::loadData(char const* filename)
 {
     // Unload old data if exist
     unloadData();
 
-    GridMapFileHeader header;
+    if (sWorld.getConfig(CONFIG_BOOL_MAP_FILES_MEMORY_MAPPED))
+        return loadMappedData(filename);
+
     // Not return error if file not found
     FILE* in = fopen(filename, "rb");
     if (!in)
@@ -92,10 +157,54 @@ bool GridMap::loadData(char const* filename)
         return true;
     }
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    GridMapReader reader(in);
+    bool result = loadSections(reader, filename);
+    fclose(in);
+    return result;
+}
+
+bool GridMap::loadMappedData(char const* filename)
+{
+    using namespace boost::interprocess;
+
+    try
+    {
+        // the mapping is shared read-only, so the pages live in the OS page cache once for all users of the file
+        file_mapping file(filename, read_only);
+        m_mappedFile.reset(new mapped_region(file, read_only));
+    }
+    catch (interprocess_exception const& e)
+    {
+        // Not return error if file not found
+        if (e.get_error_code() == not_found_error)
+        {
+            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Failled to found %s", filename);
+            // its a valid error only in case of no vmap files are available too
+            return true;
+        }
+
+        sLog.outError("Error mapping map file '%s': %s", filename, e.what());
+        return false;
+    }
+
+    m_mappedFile->advise(mapped_region::advice_willneed);
+
+    GridMapReader reader(static_cast<uint8 const*>(m_mappedFile->get_address()), m_mappedFile->get_size());
+    if (!loadSections(reader, filename))
+    {
+        unloadData();
+        return false;
+    }
+
+    return true;
+}
+
+bool GridMap::loadSections(GridMapReader& in, char const* filename)
+{
+    GridMapFileHeader header;
+    if (!in.Read(header))
     {
         sLog.outError("Error loading GridMapFileHeader\n");
-        fclose(in);
         return false;
     }
 
@@ -107,7 +216,6 @@ bool GridMap::loadData(char const* filename)
         if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
         {
             sLog.outError("Error loading map area data\n");
-            fclose(in);
             return false;
         }
 
@@ -115,7 +223,6 @@ bool GridMap::loadData(char const* filename)
         if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
         {
             sLog.outError("Error loading map height data\n");
-            fclose(in);
             return false;
         }
 
@@ -123,7 +230,6 @@ bool GridMap::loadData(char const* filename)
         if (header.liquidMapOffset && !loadGridMapLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
         {
             sLog.outError("Error loading map liquids data\n");
-            fclose(in);
             return false;
         }
 
@@ -131,38 +237,54 @@ bool GridMap::loadData(char const* filename)
         if (header.holesOffset && !loadHolesData(in, header.holesOffset, header.holesSize))
         {
             sLog.outError("Error loading map holes data\n");
-            fclose(in);
             return false;
         }
 
-        fclose(in);
         return true;
     }
 
     sLog.outError("Map file '%s' has the wrong version. Please extract the mapfiles again with the latest extractors.", filename);
-    fclose(in);
     return false;
 }
 
+bool GridMap::isMapped(void const* data) const
+{
+    if (!m_mappedFile)
+        return false;
+
+    uint8 const* begin = static_cast<uint8 const*>(m_mappedFile->get_address());
+    uint8 const* ptr = static_cast<uint8 const*>(data);
+    return ptr >= begin && ptr < begin + m_mappedFile->get_size();
+}
+
+template<typename T>
+void GridMap::freeArray(T*& data)
+{
+    if (data && !isMapped(data))
+        delete[] data;
+    data = nullptr;
+}
+
 void GridMap::unloadData()
 {
-    if (m_area_map)    { delete[] m_area_map;    m_area_map = nullptr; }
-    if (m_V9)          { delete[] m_V9;          m_V9 = nullptr; }
-    if (m_V8)          { delete[] m_V8;          m_V8 = nullptr; }
-    if (m_liquidEntry) { delete[] m_liquidEntry; m_liquidEntry = nullptr; }
-    if (m_liquidFlags) { delete[] m_liquidFlags; m_liquidFlags = nullptr; }
-    if (m_liquid_map)  { delete[] m_liquid_map;  m_liquid_map = nullptr; }
-    if (m_holes)       { delete[] m_holes;       m_holes = nullptr; }
+    freeArray(m_area_map);
+    freeArray(m_V9);
+    freeArray(m_V8);
+    freeArray(m_liquidEntry);
+    freeArray(m_liquidFlags);
+    freeArray(m_liquid_map);
+    freeArray(m_holes);
+    m_mappedFile.reset();
 
     m_gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadAreaData(GridMapReader& in, uint32 offset, uint32 /*size*/)
 {
     GridMapAreaHeader header;
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!in.Read(header))
         return false;
     if (header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
         return false;
@@ -170,20 +292,19 @@ bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
     m_gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        m_area_map = new uint16 [16 * 16];
-        if (fread(m_area_map, sizeof(uint16), 16 * 16, in) != 16 * 16)
+        if (!in.ReadArray(m_area_map, 16 * 16))
             return false;
     }
 
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(GridMapReader& in, uint32 offset, uint32 /*size*/)
 {
     GridMapHeightHeader header;
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!in.Read(header))
         return false;
     if (header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
         return false;
@@ -193,30 +314,24 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16[129 * 129];
-            m_uint16_V8 = new uint16[128 * 128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129 * 129, in) != 129 * 129 ||
-                    fread(m_uint16_V8, sizeof(uint16), 128 * 128, in) != 128 * 128)
+            if (!in.ReadArray(m_uint16_V9, 129 * 129) ||
+                    !in.ReadArray(m_uint16_V8, 128 * 128))
                 return false;
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8[129 * 129];
-            m_uint8_V8 = new uint8[128 * 128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129 * 129, in) != 129 * 129 ||
-                    fread(m_uint8_V8, sizeof(uint8), 128 * 128, in) != 128 * 128)
+            if (!in.ReadArray(m_uint8_V9, 129 * 129) ||
+                    !in.ReadArray(m_uint8_V8, 128 * 128))
                 return false;
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float[129 * 129];
-            m_V8 = new float[128 * 128];
-            if (fread(m_V9, sizeof(float), 129 * 129, in) != 129 * 129 ||
-                    fread(m_V8, sizeof(float), 128 * 128, in) != 128 * 128)
+            if (!in.ReadArray(m_V9, 129 * 129) ||
+                    !in.ReadArray(m_V8, 128 * 128))
                 return false;
             m_gridGetHeight = &GridMap::getHeightFromFloat;
         }
@@ -227,20 +342,19 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHolesData(GridMapReader& in, uint32 offset, uint32 /*size*/)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
-    m_holes = new uint16[16 * 16];
-    return fread(m_holes, sizeof(uint16), 16 * 16, in) == 16 * 16;
+    return in.ReadArray(m_holes, 16 * 16);
 }
 
-bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadGridMapLiquidData(GridMapReader& in, uint32 offset, uint32 /*size*/)
 {
     GridMapLiquidHeader header;
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    if (!in.Read(header))
         return false;
     if (header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
         return false;
@@ -255,19 +369,16 @@ bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquidEntry = new uint16[16 * 16];
-        if (fread(m_liquidEntry, sizeof(uint16), 16 * 16, in) != 16 * 16)
+        if (!in.ReadArray(m_liquidEntry, 16 * 16))
             return false;
 
-        m_liquidFlags = new uint8[16 * 16];
-        if (fread(m_liquidFlags, sizeof(uint8), 16 * 16, in) != 16 * 16)
+        if (!in.ReadArray(m_liquidFlags, 16 * 16))
             return false;
     }
 
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquid_map = new float[m_liquid_width * m_liquid_height];
-        if (fread(m_liquid_map, sizeof(float), m_liquid_width * m_liquid_height, in) != size_t(m_liquid_width * m_liquid_height))
+        if (!in.ReadArray(m_liquid_map, m_liquid_width * m_liquid_height))
             return false;
     }
 
@@ -779,6 +890,16 @@ void TerrainInfo::Unload(const uint32 x, const uint32 y)
     }
 }
 
+bool TerrainInfo::HasGridMap(const uint32 x, const uint32 y) const
+{
+    MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
+    MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
+
+    // same lock LoadMapAndVMap writes the slot with
+    LOCK_GUARD lock(m_mutex);
+    return m_GridMaps[x][y] != nullptr;
+}
+
 // call this method only
 void TerrainInfo::CleanUpGrids(const uint32 diff)
 {
@@ -1337,21 +1458,26 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnl
         // double checked lock pattern
         if (!m_GridMaps[x][y])
         {
-            GridMap* map = new GridMap();
+            // terrain may already be loaded in background ahead of player movement
+            GridMap* map = sMapMgr.GetGridPreloader().Take(m_mapId, x, y);
+            if (!map)
+            {
+                map = new GridMap();
 
-            // map file name
-            int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
-            char* tmp = new char[len];
-            snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
+                // map file name
+                int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
+                char* tmp = new char[len];
+                snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
+                DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
 
-            if (!map->loadData(tmp))
-            {
-                sLog.outError("Error loading map file: %s", tmp);
-                //assert(false);
-            }
+                if (!map->loadData(tmp))
+                {
+                    sLog.outError("Error loading map file: %s", tmp);
+                    //assert(false);
+                }
 
-            delete[] tmp;
+                delete[] tmp;
+            }
             m_GridMaps[x][y] = map;
         }
     }
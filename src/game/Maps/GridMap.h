@@ -27,6 +27,7 @@
 #include "Maps/GridMapDefines.h"
 
 #include <atomic>
+#include <memory>
 #include <mutex>
 
 class Creature;
@@ -42,6 +43,16 @@ namespace VMAP
     class IVMapManager;
 };
 
+namespace boost
+{
+    namespace interprocess
+    {
+        class mapped_region;
+    }
+}
+
+class GridMapReader;
+
 class GridMap
 {
     private:
@@ -84,10 +95,17 @@ class GridMap
         // For fast check
         bool m_fullyLoaded;
 
-        bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-        bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-        bool loadGridMapLiquidData(FILE* in, uint32 offset, uint32 size);
-        bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+        // Read-only mapping of the whole .map file, the arrays above point into it when loaded memory mapped
+        std::unique_ptr<boost::interprocess::mapped_region> m_mappedFile;
+
+        bool loadMappedData(char const* filename);
+        bool loadSections(GridMapReader& in, char const* filename);
+        bool loadAreaData(GridMapReader& in, uint32 offset, uint32 size);
+        bool loadHeightData(GridMapReader& in, uint32 offset, uint32 size);
+        bool loadGridMapLiquidData(GridMapReader& in, uint32 offset, uint32 size);
+        bool loadHolesData(GridMapReader& in, uint32 offset, uint32 size);
+        bool isMapped(void const* data) const;
+        template<typename T> void freeArray(T*& data);
         bool isHole(int row, int col) const;
 
         // Get height functions and pointers
@@ -181,6 +199,7 @@ class TerrainInfo : public Referencable<std::atomic_long>
         // load/unload terrain data
         GridMap* Load(const uint32 x, const uint32 y, bool mapOnly = false);
         void Unload(const uint32 x, const uint32 y);
+        bool HasGridMap(const uint32 x, const uint32 y) const;
 
     private:
         TerrainInfo(const TerrainInfo&);
@@ -205,7 +224,7 @@ class TerrainInfo : public Referencable<std::atomic_long>
 
         typedef std::mutex LOCK_TYPE;
         typedef std::lock_guard<LOCK_TYPE> LOCK_GUARD;
-        LOCK_TYPE m_mutex;
+        mutable LOCK_TYPE m_mutex;                          // guards GridMap slot writes, maps of other instances load terrain concurrently
         LOCK_TYPE m_refMutex;
 };
 
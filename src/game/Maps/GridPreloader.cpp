@@ -0,0 +1,168 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/GridPreloader.h"
+#include "Maps/GridMap.h"
+#include "Vmap/MapTree.h"
+#include "Log/Log.h"
+#include "World/World.h"
+#include "Util/Timer.h"
+
+// preloaded grids nobody entered are dropped after this time
+static uint32 const GRID_PRELOAD_EXPIRE_TIME = 60 * IN_MILLISECONDS;
+// how often the worker looks for expired grids, also while requests keep it busy
+static uint32 const GRID_PRELOAD_EXPIRE_CHECK_INTERVAL = 10 * IN_MILLISECONDS;
+
+GridPreloader::~GridPreloader()
+{
+    deactivate();
+
+    for (auto& grid : m_grids)
+        delete grid.second.gridMap;
+}
+
+void GridPreloader::activate()
+{
+    if (m_running)
+        return;
+
+    m_running = true;
+    m_thread = std::thread(&GridPreloader::WorkerThread, this);
+}
+
+void GridPreloader::deactivate()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (!m_running)
+            return;
+        m_running = false;
+    }
+
+    m_condition.notify_all();
+    m_thread.join();
+}
+
+void GridPreloader::Request(uint32 mapId, uint32 gx, uint32 gy)
+{
+    uint32 key = MakeKey(mapId, gx, gy);
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (!m_running || !m_grids.emplace(key, PreloadedGrid{ nullptr, 0 }).second)
+            return;
+
+        m_queue.push_back(key);
+    }
+
+    m_condition.notify_one();
+}
+
+GridMap* GridPreloader::Take(uint32 mapId, uint32 gx, uint32 gy)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    auto itr = m_grids.find(MakeKey(mapId, gx, gy));
+    if (itr == m_grids.end() || !itr->second.gridMap)
+        return nullptr;
+
+    GridMap* gridMap = itr->second.gridMap;
+    m_grids.erase(itr);
+    return gridMap;
+}
+
+void GridPreloader::WorkerThread()
+{
+    std::unique_lock<std::mutex> guard(m_lock);
+    uint32 lastExpireCheck = WorldTimer::getMSTime();
+    while (m_running)
+    {
+        uint32 now = WorldTimer::getMSTime();
+        if (WorldTimer::getMSTimeDiff(lastExpireCheck, now) >= GRID_PRELOAD_EXPIRE_CHECK_INTERVAL)
+        {
+            RemoveExpired();
+            lastExpireCheck = now;
+        }
+
+        if (m_queue.empty())
+        {
+            m_condition.wait_for(guard, std::chrono::milliseconds(GRID_PRELOAD_EXPIRE_CHECK_INTERVAL));
+            continue;
+        }
+
+        uint32 key = m_queue.front();
+        m_queue.pop_front();
+
+        guard.unlock();
+        GridMap* gridMap = Load(key >> 12, (key >> 6) & 0x3F, key & 0x3F);
+        guard.lock();
+
+        if (gridMap)
+            m_grids[key] = PreloadedGrid{ gridMap, WorldTimer::getMSTime() };
+        else
+            m_grids.erase(key);
+    }
+}
+
+void GridPreloader::RemoveExpired()
+{
+    uint32 now = WorldTimer::getMSTime();
+    for (auto itr = m_grids.begin(); itr != m_grids.end();)
+    {
+        if (itr->second.gridMap && WorldTimer::getMSTimeDiff(itr->second.readyTime, now) > GRID_PRELOAD_EXPIRE_TIME)
+        {
+            delete itr->second.gridMap;
+            itr = m_grids.erase(itr);
+        }
+        else
+            ++itr;
+    }
+}
+
+// read a file once so its later synchronous load doesn't touch the disk
+static void ReadAhead(std::string const& filename)
+{
+    FILE* in = fopen(filename.c_str(), "rb");
+    if (!in)
+        return;
+
+    char buffer[64 * 1024];
+    while (fread(buffer, 1, sizeof(buffer), in) == sizeof(buffer))
+        ;
+
+    fclose(in);
+}
+
+GridMap* GridPreloader::Load(uint32 mapId, uint32 gx, uint32 gy) const
+{
+    char fileName[32];
+    snprintf(fileName, sizeof(fileName), "maps/%03u%02u%02u.map", mapId, gx, gy);
+
+    GridMap* gridMap = new GridMap();
+    if (!gridMap->loadData((sWorld.GetDataPath() + fileName).c_str()))
+    {
+        delete gridMap;
+        return nullptr;
+    }
+
+    ReadAhead(sWorld.GetDataPath() + "vmaps/" + VMAP::StaticMapTree::getTileFileName(mapId, gx, gy));
+
+    snprintf(fileName, sizeof(fileName), "mmaps/%03u%02u%02u.mmtile", mapId, gx, gy);
+    ReadAhead(sWorld.GetDataPath() + fileName);
+
+    DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "GridPreloader: preloaded grid [%u,%u] of map %u", gx, gy, mapId);
+    return gridMap;
+}
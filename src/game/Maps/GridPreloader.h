@@ -0,0 +1,74 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_GRIDPRELOADER_H
+#define MANGOS_GRIDPRELOADER_H
+
+#include "Platform/Define.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <deque>
+#include <unordered_map>
+#include <condition_variable>
+
+class GridMap;
+
+// loads the terrain of grids players are about to enter on a background thread
+// maps request grids ahead of player movement (see Map::PreloadGridsAhead), TerrainInfo takes
+// the loaded GridMap when the grid gets created, the vmap and navmesh tile files are read ahead
+// so their synchronous load in the map thread is served from the OS page cache
+class GridPreloader
+{
+    public:
+        GridPreloader() : m_running(false) {}
+        GridPreloader(const GridPreloader&) = delete;
+        ~GridPreloader();
+
+        void activate();
+        void deactivate();
+        bool activated() const { return m_running; }
+
+        // queue loading of grid gx, gy (terrain coordinates), called from map threads
+        void Request(uint32 mapId, uint32 gx, uint32 gy);
+        // hand over the preloaded terrain of the grid, nullptr when it's not ready
+        GridMap* Take(uint32 mapId, uint32 gx, uint32 gy);
+
+    private:
+        struct PreloadedGrid
+        {
+            GridMap* gridMap;                               // nullptr while loading
+            uint32 readyTime;
+        };
+
+        static uint32 MakeKey(uint32 mapId, uint32 gx, uint32 gy) { return (mapId << 12) | (gx << 6) | gy; }
+
+        void WorkerThread();
+        GridMap* Load(uint32 mapId, uint32 gx, uint32 gy) const;
+        void RemoveExpired();
+
+        std::mutex m_lock;
+        std::condition_variable m_condition;
+        std::deque<uint32> m_queue;
+        std::unordered_map<uint32, PreloadedGrid> m_grids;  // requested grids, loaded ones wait here for the map
+        std::thread m_thread;
+        std::atomic<bool> m_running;                        // read by map threads without m_lock
+};
+
+#endif
@@ -43,6 +43,8 @@
 #include "Grids/ObjectGridLoader.h"
 #include "Vmap/GameObjectModel.h"
 #include "LFG/LFGMgr.h"
+#include "Maps/MapWorkers.h"
+#include "Movement/MoveSpline.h"
 
 #ifdef BUILD_METRICS
  #include "Metric/Metric.h"
@@ -50,6 +52,9 @@
 
 #include <time.h>
 
+// how often maps look at the movement of their players for grids to preload (in milliseconds)
+static uint32 const GRID_PRELOAD_INTERVAL = 1000;
+
 Map::~Map()
 {
     UnloadAll(true);
@@ -218,11 +223,33 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
       i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0), m_clientUpdateTimer(0),
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(nullptr),
       m_activeNonPlayersIter(m_activeNonPlayers.end()), m_onEventNotifiedIter(m_onEventNotifiedObjects.end()),
-      i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
+      m_lastUpdateDuration(0), m_parallelUpdate(false), m_gridPreloadTimer(0), m_gridLoadTime(0), m_gridLoadCount(0), i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
       i_data(nullptr), i_script_id(0), m_transportsIterator(m_transports.begin()), m_defaultLight(GetDefaultMapLight(id)), m_spawnManager(*this),
       m_variableManager(this)
 {
     m_weatherSystem = new WeatherSystem(this);
+
+#ifdef BUILD_METRICS
+    std::map<std::string, std::string> tags = {
+        { "map_id", std::to_string(i_id) },
+        { "instance_id", std::to_string(i_InstanceId) }
+    };
+    // histograms take ~500 cells each, all instances of a map share them so their number doesn't grow with the instances
+    std::map<std::string, std::string> mapTags = { { "map_id", std::to_string(i_id) } };
+    m_updateMetric.reset(new metric::histogram("map.update", mapTags));
+    m_sessionUpdateMetric.reset(new metric::histogram("map.update.session", mapTags));
+    m_objectCountMetric.reset(new metric::gauge("map.update.count", tags));
+    m_sessionCountMetric.reset(new metric::gauge("map.update.session.count", tags));
+    m_gridLoadMetric.reset(new metric::histogram("map.grid_load", mapTags));
+    m_gridLoadCountMetric.reset(new metric::counter("map.grid_load.count", tags));
+
+    char const* tierNames[MAX_CREATURE_UPDATE_TIER] = { "full", "idle" };
+    for (uint32 i = 0; i < MAX_CREATURE_UPDATE_TIER; ++i)
+    {
+        tags["tier"] = tierNames[i];
+        m_creatureTierMetric.emplace_back(new metric::gauge("map.update.creature_tier", tags));
+    }
+#endif
 }
 
 void Map::Initialize(bool loadInstanceData /*= true*/)
@@ -376,6 +403,8 @@ void Map::EnsureGridCreated(const GridPair& p)
 {
     if (!getNGrid(p.x_coord, p.y_coord))
     {
+        std::chrono::steady_clock::time_point loadStart = std::chrono::steady_clock::now();
+
         setNGrid(new NGridType(p.x_coord * MAX_NUMBER_OF_GRIDS + p.y_coord, p.x_coord, p.y_coord, i_gridExpiry, sWorld.getConfig(CONFIG_BOOL_GRID_UNLOAD)),
                  p.x_coord, p.y_coord);
 
@@ -390,6 +419,8 @@ void Map::EnsureGridCreated(const GridPair& p)
 
         if (!m_bLoadedGrids[gx][gy])
             LoadMapAndVMap(gx, gy);
+
+        m_gridLoadTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - loadStart).count();
     }
 }
 
@@ -434,11 +465,16 @@ bool Map::EnsureGridLoaded(const Cell& cell)
         // active object A(loaded with loader.LoadN call and added to the  map)
         // summons some active object B, while B added to map grid loading called again and so on..
         setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
+        std::chrono::steady_clock::time_point loadStart = std::chrono::steady_clock::now();
+
         ObjectGridLoader loader(*grid, this, cell);
         loader.LoadN();
 
         // Add resurrectable corpses to world object list in grid
         sObjectAccessor.AddCorpsesToGrid(GridPair(cell.GridX(), cell.GridY()), (*grid)(cell.CellX(), cell.CellY()), this);
+
+        m_gridLoadTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - loadStart).count();
+        ++m_gridLoadCount;
         return true;
     }
 
@@ -521,6 +557,8 @@ void Map::Add(T* obj)
         return;
     }
 
+    auto guard = LockForParallelUpdate();
+
     obj->SetMap(this);
 
     Cell cell(p);
@@ -541,9 +579,18 @@ void Map::Add(T* obj)
     DEBUG_FILTER_LOG(LOG_FILTER_CREATURE_MOVES, "%s enters grid[%u,%u]", obj->GetGuidStr().c_str(), cell.GridX(), cell.GridY());
 
     obj->GetViewPoint().Event_AddedToWorld(&(*grid)(cell.CellX(), cell.CellY()));
-    obj->SetItsNewObject(true);
-    UpdateObjectVisibility(obj, cell, p);
-    obj->SetItsNewObject(false);
+
+    auto updateVisibility = [obj, cell, p](Map* map)
+    {
+        obj->SetItsNewObject(true);
+        map->UpdateObjectVisibility(obj, cell, p);
+        obj->SetItsNewObject(false);
+    };
+
+    if (IsUpdatingInParallel())
+        m_parallelUpdateMessager.AddMessage(updateVisibility);
+    else
+        updateVisibility(this);
 }
 
 void Map::MessageBroadcast(Player const* player, WorldPacket const& msg, bool to_self)
@@ -735,10 +782,7 @@ void Map::Update(const uint32& t_diff)
 {
 
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::milliseconds> meas("map.update", {
-        { "map_id", std::to_string(i_id) },
-        { "instance_id", std::to_string(i_InstanceId) }
-});
+    metric::scoped_timer<std::chrono::microseconds> meas(*m_updateMetric);
 #endif
 
     m_curTime = time(nullptr);
@@ -776,10 +820,7 @@ void Map::Update(const uint32& t_diff)
     {
 #ifdef BUILD_METRICS
         uint32 updatedSessions = 0;
-        metric::duration<std::chrono::milliseconds> sessions_meas("map.update.session", {
-            { "map_id", std::to_string(i_id) },
-            { "instance_id", std::to_string(i_InstanceId) },
-            });
+        metric::scoped_timer<std::chrono::microseconds> sessions_meas(*m_sessionUpdateMetric);
 #endif
 
         for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -796,7 +837,7 @@ void Map::Update(const uint32& t_diff)
 #endif
         }
 #ifdef BUILD_METRICS
-        sessions_meas.add_field("count", std::to_string(static_cast<int32>(updatedSessions)));
+        m_sessionCountMetric->set(updatedSessions);
 #endif
     }
 
@@ -808,6 +849,15 @@ void Map::Update(const uint32& t_diff)
             plr->Update(t_diff);
     }
 
+    // queue terrain loading of grids players are heading to
+    m_gridPreloadTimer += t_diff;
+    if (m_gridPreloadTimer >= GRID_PRELOAD_INTERVAL)
+    {
+        m_gridPreloadTimer = 0;
+        if (sMapMgr.GetGridPreloader().activated())
+            PreloadGridsAhead();
+    }
+
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
         Player* player = m_mapRefIter->getSource();
@@ -862,15 +912,34 @@ void Map::Update(const uint32& t_diff)
         }
     }
 
+#ifdef BUILD_METRICS
+    uint32 creatureTierCount[MAX_CREATURE_UPDATE_TIER] = {};
+    for (WorldObject* wObj : objToUpdate)
+        if (wObj->GetTypeId() == TYPEID_UNIT)
+            ++creatureTierCount[static_cast<Creature*>(wObj)->GetUpdateTier()];
+
+    for (uint32 i = 0; i < MAX_CREATURE_UPDATE_TIER; ++i)
+        m_creatureTierMetric[i]->set(creatureTierCount[i]);
+#endif
+
     // update all objects
-    for (auto wObj : objToUpdate)
+    if (sWorld.getConfig(CONFIG_BOOL_MAP_PARALLEL_UPDATE) && IsContinent() && sMapMgr.GetMapUpdater().activated() &&
+        objToUpdate.size() >= sWorld.getConfig(CONFIG_UINT32_MAP_PARALLEL_UPDATE_MIN_OBJECTS))
     {
-        wObj->Update(t_diff);
-        ++count;
+        UpdateObjectsInParallel(objToUpdate, t_diff);
+        count += objToUpdate.size();
+    }
+    else
+    {
+        for (auto wObj : objToUpdate)
+        {
+            wObj->Update(t_diff);
+            ++count;
+        }
     }
 
 #ifdef BUILD_METRICS
-    meas.add_field("count", std::to_string(static_cast<int32>(count)));
+    m_objectCountMetric->set(count);
 #endif
 
     // Send world objects and item update field changes
@@ -903,6 +972,118 @@ void Map::Update(const uint32& t_diff)
         i_data->Update(t_diff);
 
     m_weatherSystem->UpdateWeathers(t_diff);
+
+    if (m_gridLoadTime)
+    {
+#ifdef BUILD_METRICS
+        m_gridLoadMetric->record(m_gridLoadTime);
+        m_gridLoadCountMetric->add(m_gridLoadCount);
+#endif
+        m_gridLoadTime = 0;
+        m_gridLoadCount = 0;
+    }
+}
+
+void Map::PreloadGridsAhead()
+{
+    uint32 lookahead = sWorld.getConfig(CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD);
+
+    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    {
+        Player* player = m_mapRefIter->getSource();
+        if (!player->IsInWorld() || !player->IsPositionValid() || player->GetTransport())
+            continue;
+
+        if (!player->movespline->Finalized())
+        {
+            // follow the spline (taxi flights) up to the lookahead time
+            Movement::MoveSpline::MySpline const& spline = player->movespline->_Spline();
+            for (int32 i = player->movespline->GetRawPathIndex() + 1; i <= spline.last(); ++i)
+            {
+                if (player->movespline->ComputeTimeToIndex(i) > int32(lookahead))
+                    break;
+
+                G3D::Vector3 const& point = spline.getPoint(i);
+                PreloadGridsAround(point.x, point.y);
+            }
+        }
+        else if (player->IsMovingForward())
+        {
+            // extrapolate the current direction, sampled in half grid steps
+            float distance = player->GetSpeed(player->IsFlying() ? MOVE_FLIGHT : MOVE_RUN) * lookahead / IN_MILLISECONDS;
+            float angle = player->GetOrientation();
+            for (float step = SIZE_OF_GRIDS / 2; ; step += SIZE_OF_GRIDS / 2)
+            {
+                float dist = std::min(step, distance);
+                PreloadGridsAround(player->GetPositionX() + dist * cos(angle), player->GetPositionY() + dist * sin(angle));
+                if (dist >= distance)
+                    break;
+            }
+        }
+    }
+}
+
+void Map::PreloadGridsAround(float x, float y)
+{
+    float radius = GetVisibilityDistance();
+    float const corners[4][2] = { { x - radius, y - radius }, { x - radius, y + radius }, { x + radius, y - radius }, { x + radius, y + radius } };
+
+    for (auto const& corner : corners)
+    {
+        GridPair p = MaNGOS::ComputeGridPair(corner[0], corner[1]);
+        if (p.x_coord >= MAX_NUMBER_OF_GRIDS || p.y_coord >= MAX_NUMBER_OF_GRIDS || getNGrid(p.x_coord, p.y_coord))
+            continue;
+
+        // z coord
+        int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+        int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+
+        if (m_bLoadedGrids[gx][gy] || m_TerrainData->HasGridMap(gx, gy))
+            continue;
+
+        sMapMgr.GetGridPreloader().Request(GetId(), gx, gy);
+    }
+}
+
+void Map::UpdateObjectsInParallel(WorldObjectUnSet& objects, uint32 diff)
+{
+    MapUpdater& updater = sMapMgr.GetMapUpdater();
+
+    // grids are split into 4 passes by the parity of their coordinates, so two regions updated at the same time
+    // always have a full grid between them and only very long ranged effects can reach objects of both
+    std::vector<WorldObject*> pending(objects.begin(), objects.end());
+    for (uint32 pass = 0; pass < 4 && !pending.empty(); ++pass)
+    {
+        std::unordered_map<uint32, std::vector<WorldObject*>> regions;
+        std::vector<WorldObject*> later;
+        later.reserve(pending.size());
+
+        for (WorldObject* obj : pending)
+        {
+            GridPair grid = MaNGOS::ComputeGridPair(obj->GetPositionX(), obj->GetPositionY());
+            if ((grid.x_coord & 1) + ((grid.y_coord & 1) << 1) == pass)
+                regions[grid.x_coord * MAX_NUMBER_OF_GRIDS + grid.y_coord].push_back(obj);
+            else
+                later.push_back(obj);
+        }
+        pending.swap(later);
+
+        std::vector<Worker*> workers;
+        workers.reserve(regions.size());
+        for (auto& region : regions)
+            workers.push_back(new ObjectUpdateWorker(std::move(region.second), diff, updater));
+
+        m_parallelUpdate = true;
+        updater.execute_batch(workers);
+        m_parallelUpdate = false;
+
+        // merge step - relocations, removals and visibility updates queued by the regions, in queueing order
+        m_parallelUpdateMessager.Execute(this);
+    }
+
+    // objects moved into a grid whose pass already finished
+    for (WorldObject* obj : pending)
+        obj->Update(diff);
 }
 
 void Map::Remove(Player* player, bool remove)
@@ -964,6 +1145,12 @@ void Map::Remove(Player* player, bool remove)
 template<class T>
 void Map::Remove(T* obj, bool remove)
 {
+    if (IsUpdatingInParallel())
+    {
+        m_parallelUpdateMessager.AddMessage([obj, remove](Map* map) { map->Remove(obj, remove); });
+        return;
+    }
+
     CellPair p = MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
     {
@@ -1007,6 +1194,12 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
 {
     MANGOS_ASSERT(player);
 
+    if (IsUpdatingInParallel())
+    {
+        m_parallelUpdateMessager.AddMessage([=](Map* map) { map->PlayerRelocation(player, x, y, z, orientation); });
+        return;
+    }
+
     CellPair old_val = MaNGOS::ComputeCellPair(player->GetPositionX(), player->GetPositionY());
     CellPair new_val = MaNGOS::ComputeCellPair(x, y);
 
@@ -1045,6 +1238,19 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
 {
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
 
+    if (IsUpdatingInParallel())
+    {
+        // moves inside the current cell do not touch grid containers, only their notifications have to wait
+        if (new_cell != creature->GetCurrentCell())
+            m_parallelUpdateMessager.AddMessage([=](Map* map) { map->CreatureRelocation(creature, x, y, z, ang); });
+        else
+        {
+            creature->Relocate(x, y, z, ang);
+            m_parallelUpdateMessager.AddMessage([creature](Map*) { creature->OnRelocated(); });
+        }
+        return;
+    }
+
     // do move or do move to respawn or remove creature if previous all fail
     if (CreatureCellRelocation(creature, new_cell))
     {
@@ -1063,6 +1269,12 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
 
 void Map::GameObjectRelocation(GameObject* go, float x, float y, float z, float orientation, bool respawnRelocationOnFail)
 {
+    if (IsUpdatingInParallel())
+    {
+        m_parallelUpdateMessager.AddMessage([=](Map* map) { map->GameObjectRelocation(go, x, y, z, orientation, respawnRelocationOnFail); });
+        return;
+    }
+
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
     Cell old_cell = go->GetCurrentCell();
 
@@ -1096,6 +1308,12 @@ void Map::GameObjectRelocation(GameObject* go, float x, float y, float z, float
 
 void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float z, float orientation)
 {
+    if (IsUpdatingInParallel())
+    {
+        m_parallelUpdateMessager.AddMessage([=](Map* map) { map->DynamicObjectRelocation(dynObj, x, y, z, orientation); });
+        return;
+    }
+
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
     Cell old_cell = dynObj->GetCurrentCell();
 
@@ -1381,6 +1599,13 @@ const char* Map::GetMapName() const
 
 void Map::UpdateObjectVisibility(WorldObject* obj, Cell cell, const CellPair& cellpair)
 {
+    if (IsUpdatingInParallel())
+    {
+        CellPair pair = cellpair;
+        m_parallelUpdateMessager.AddMessage([obj, cell, pair](Map* map) { map->UpdateObjectVisibility(obj, cell, pair); });
+        return;
+    }
+
     cell.SetNoCreate();
     MaNGOS::VisibleChangesNotifier notifier(*obj);
     TypeContainerVisitor<MaNGOS::VisibleChangesNotifier, WorldTypeMapContainer > player_notifier(notifier);
@@ -1507,6 +1732,12 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 {
     MANGOS_ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
+    if (IsUpdatingInParallel())
+    {
+        m_parallelUpdateMessager.AddMessage([obj](Map* map) { map->AddObjectToRemoveList(obj); });
+        return;
+    }
+
     obj->CleanupsBeforeDelete();                            // remove or simplify at least cross referenced links
 
     i_objectsToRemove.insert(obj);
@@ -2263,6 +2494,7 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
 
     if (delay)
     {
+        auto guard = LockForParallelUpdate();
         m_scriptSchedule.emplace(GetCurrentClockTime() + std::chrono::milliseconds(delay), sa);
     }
     else
@@ -2325,6 +2557,7 @@ Player* Map::GetPlayer(ObjectGuid guid)
  */
 Creature* Map::GetCreature(ObjectGuid guid)
 {
+    auto guard = LockForParallelUpdate();
     return m_objectsStore.find<Creature>(guid, (Creature*)nullptr);
 }
 
@@ -2335,6 +2568,7 @@ Creature* Map::GetCreature(ObjectGuid guid)
  */
 Pet* Map::GetPet(ObjectGuid guid)
 {
+    auto guard = LockForParallelUpdate();
     return m_objectsStore.find<Pet>(guid, (Pet*)nullptr);
 }
 
@@ -2376,6 +2610,7 @@ Creature* Map::GetAnyTypeCreature(ObjectGuid guid)
  */
 GameObject* Map::GetGameObject(ObjectGuid guid)
 {
+    auto guard = LockForParallelUpdate();
     return m_objectsStore.find<GameObject>(guid, (GameObject*)nullptr);
 }
 
@@ -2386,6 +2621,7 @@ GameObject* Map::GetGameObject(ObjectGuid guid)
  */
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    auto guard = LockForParallelUpdate();
     return m_objectsStore.find<DynamicObject>(guid, (DynamicObject*)nullptr);
 }
 
@@ -2434,12 +2670,25 @@ WorldObject* Map::GetWorldObject(ObjectGuid guid)
 
 void Map::SendObjectUpdates()
 {
+    if (sWorld.getConfig(CONFIG_BOOL_MAP_PARALLEL_SEND) && sMapMgr.GetMapUpdater().activated() &&
+        i_objectsToClientUpdate.size() >= sWorld.getConfig(CONFIG_UINT32_MAP_PARALLEL_SEND_MIN_OBJECTS))
+    {
+        std::vector<Object*> objects;
+        objects.swap(i_objectsToClientUpdate);
+        for (Object* obj : objects)
+            obj->SetClientUpdateSlot(CLIENT_UPDATE_SLOT_NONE);
+
+        SendObjectUpdatesInParallel(objects);
+        return;
+    }
+
     UpdateDataMapType update_players;
 
     while (!i_objectsToClientUpdate.empty())
     {
-        Object* obj = *i_objectsToClientUpdate.begin();
-        i_objectsToClientUpdate.erase(i_objectsToClientUpdate.begin());
+        Object* obj = i_objectsToClientUpdate.back();
+        i_objectsToClientUpdate.pop_back();
+        obj->SetClientUpdateSlot(CLIENT_UPDATE_SLOT_NONE);
         obj->BuildUpdateData(update_players);
     }
 
@@ -2453,6 +2702,59 @@ void Map::SendObjectUpdates()
     }
 }
 
+void Map::SendObjectUpdatesInParallel(std::vector<Object*>& objects)
+{
+    MapUpdater& updater = sMapMgr.GetMapUpdater();
+
+    // building only reads the world, every chunk collects into its own map which are merged per player afterwards
+    size_t chunkSize = std::max<size_t>(objects.size() / ((updater.thread_count() + 1) * 4), 32);
+    size_t chunkCount = (objects.size() + chunkSize - 1) / chunkSize;
+    std::vector<UpdateDataMapType> chunkData(chunkCount);
+
+    std::vector<Worker*> workers;
+    workers.reserve(chunkCount);
+    for (size_t i = 0; i < chunkCount; ++i)
+    {
+        auto begin = objects.begin() + i * chunkSize;
+        auto end = objects.begin() + std::min((i + 1) * chunkSize, objects.size());
+        workers.push_back(new UpdateDataBuildWorker(std::vector<Object*>(begin, end), chunkData[i], updater));
+    }
+    updater.execute_batch(workers);
+
+    UpdateDataMapType update_players = std::move(chunkData[0]);
+    for (size_t i = 1; i < chunkCount; ++i)
+    {
+        for (auto& data : chunkData[i])
+        {
+            auto itr = update_players.find(data.first);
+            if (itr == update_players.end())
+                update_players.emplace(data.first, std::move(data.second));
+            else
+                itr->second.Merge(data.second);
+        }
+    }
+
+    // compression is the expensive part of building the packets, sending stays on the map thread
+    std::vector<std::pair<Player*, UpdateData*>> receivers;
+    receivers.reserve(update_players.size());
+    for (auto& update_player : update_players)
+        receivers.emplace_back(update_player.first, &update_player.second);
+
+    std::vector<std::vector<WorldPacket>> packets(receivers.size());
+
+    chunkSize = std::max<size_t>(receivers.size() / ((updater.thread_count() + 1) * 4), 4);
+    for (size_t begin = 0; begin < receivers.size(); begin += chunkSize)
+    {
+        size_t end = std::min(begin + chunkSize, receivers.size());
+        workers.push_back(new UpdatePacketBuildWorker(receivers, packets, begin, end, updater));
+    }
+    updater.execute_batch(workers);
+
+    for (size_t i = 0; i < receivers.size(); ++i)
+        for (WorldPacket const& packet : packets[i])
+            receivers[i].first->GetSession()->SendPacket(packet);
+}
+
 Creature* Map::GetCreature(uint32 dbguid) const
 {
     auto itr = m_dbGuidObjects.find(std::make_pair(HIGHGUID_UNIT, dbguid));
@@ -40,9 +40,11 @@
 #include "Maps/MapDataContainer.h"
 #include "World/WorldStateVariableManager.h"
 
+#include <atomic>
 #include <bitset>
 #include <functional>
 #include <list>
+#include <mutex>
 
 struct CreatureInfo;
 class Creature;
@@ -62,6 +64,9 @@ class WeatherSystem;
 class GenericTransport;
 namespace MaNGOS { struct ObjectUpdater; }
 class Transport;
+#ifdef BUILD_METRICS
+namespace metric { class counter; class gauge; class histogram; }
+#endif
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -326,14 +331,42 @@ class Map : public GridRefManager<NGridType>
         std::map<uint32, uint32>& GetTempCreatures() { return m_tempCreatures; }
         std::map<uint32, uint32>& GetTempPets() { return m_tempPets; }
 
+        // the object remembers its slot in the list, callers guarantee that it is added only once (Object::m_objectUpdated)
         void AddUpdateObject(Object* obj)
         {
-            i_objectsToClientUpdate.insert(obj);
+            auto guard = LockForParallelUpdate();
+            obj->SetClientUpdateSlot(uint32(i_objectsToClientUpdate.size()));
+            i_objectsToClientUpdate.push_back(obj);
         }
 
         void RemoveUpdateObject(Object* obj)
         {
-            i_objectsToClientUpdate.erase(obj);
+            auto guard = LockForParallelUpdate();
+            uint32 slot = obj->GetClientUpdateSlot();
+            if (slot >= i_objectsToClientUpdate.size() || i_objectsToClientUpdate[slot] != obj)
+                return;
+
+            i_objectsToClientUpdate[slot] = i_objectsToClientUpdate.back();
+            i_objectsToClientUpdate[slot]->SetClientUpdateSlot(slot);
+            i_objectsToClientUpdate.pop_back();
+            obj->SetClientUpdateSlot(CLIENT_UPDATE_SLOT_NONE);
+        }
+
+        // true while object updates of several grid regions run concurrently - grid changes, removals and
+        // visibility updates are then queued and executed once the current pass finished
+        bool IsUpdatingInParallel() const { return m_parallelUpdate; }
+
+        // runs work touching map wide state (respawn times, spawn lists, pools, linking holder, creature groups,
+        // instance data, group kill rewards) right away, or queues it until the current parallel pass finished
+        // when called from a region worker
+        // writes between units in combat (threat, hostile references, damage, auras) stay direct: regions of one pass
+        // are a full grid apart, far beyond any melee or spell range, so both units always belong to the same region
+        void ExecuteSerialized(std::function<void(Map*)> const& work)
+        {
+            if (m_parallelUpdate)
+                m_parallelUpdateMessager.AddMessage(work);
+            else
+                work(this);
         }
 
         // DynObjects currently
@@ -404,6 +437,10 @@ class Map : public GridRefManager<NGridType>
 
         Messager<Map>& GetMessager() { return m_messager; }
 
+        // duration of the last threaded update, used to order and balance map updates
+        uint32 GetLastUpdateDuration() const { return m_lastUpdateDuration; }
+        void SetLastUpdateDuration(uint32 duration) { m_lastUpdateDuration = duration; }
+
         typedef std::set<Transport*> TransportSet;
         GenericTransport* GetTransport(ObjectGuid guid);
         TransportSet const& GetTransports() { return m_transports; }
@@ -456,6 +493,9 @@ class Map : public GridRefManager<NGridType>
         bool EnsureGridLoaded(Cell const&);
         void EnsureGridLoadedAtEnter(Cell const&, Player* player = nullptr);
 
+        void PreloadGridsAhead();
+        void PreloadGridsAround(float x, float y);
+
         void buildNGridLinkage(NGridType* pNGridType) { pNGridType->link(this); }
 
         NGridType* getNGrid(uint32 x, uint32 y) const
@@ -472,7 +512,17 @@ class Map : public GridRefManager<NGridType>
         void ScriptsProcess();
 
         void SendObjectUpdates();
-        std::set<Object*> i_objectsToClientUpdate;
+        void SendObjectUpdatesInParallel(std::vector<Object*>& objects);
+        std::vector<Object*> i_objectsToClientUpdate;
+
+        void UpdateObjectsInParallel(WorldObjectUnSet& objects, uint32 diff);
+        // serialises access to map wide containers, only locks while objects are updated in parallel
+        std::unique_lock<std::recursive_mutex> LockForParallelUpdate()
+        {
+            if (!m_parallelUpdate)
+                return std::unique_lock<std::recursive_mutex>();
+            return std::unique_lock<std::recursive_mutex>(m_parallelUpdateLock);
+        }
 
     protected:
         MapEntry const* i_mapEntry;
@@ -502,6 +552,26 @@ class Map : public GridRefManager<NGridType>
 
         GraveyardManager m_graveyardManager;
     private:
+        uint32 m_lastUpdateDuration;
+        std::atomic<bool> m_parallelUpdate;
+        std::recursive_mutex m_parallelUpdateLock;
+        Messager<Map> m_parallelUpdateMessager;             // side effects deferred until the end of a parallel update pass
+
+        uint32 m_gridPreloadTimer;
+        uint64 m_gridLoadTime;                              // time spent in synchronous grid loading this tick (in microseconds)
+        uint32 m_gridLoadCount;
+
+#ifdef BUILD_METRICS
+        // registered once per map instead of building tagged measurements every tick
+        std::unique_ptr<metric::histogram> m_updateMetric;
+        std::unique_ptr<metric::gauge> m_objectCountMetric;
+        std::unique_ptr<metric::histogram> m_sessionUpdateMetric;
+        std::unique_ptr<metric::gauge> m_sessionCountMetric;
+        std::unique_ptr<metric::histogram> m_gridLoadMetric;
+        std::unique_ptr<metric::counter> m_gridLoadCountMetric;
+        std::vector<std::unique_ptr<metric::gauge>> m_creatureTierMetric; // indexed by CreatureUpdateTier
+#endif
+
         time_t i_gridExpiry;
         time_t m_curTime;
         tm m_curTimeTm;
@@ -27,6 +27,7 @@
 #include "Grids/CellImpl.h"
 #include "Globals/ObjectMgr.h"
 #include "Maps/MapWorkers.h"
+#include <algorithm>
 #include <future>
 
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex>
@@ -55,6 +56,9 @@ void MapManager::Initialize()
     int num_threads(sWorld.getConfig(CONFIG_UINT32_NUM_MAP_THREADS));
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (sWorld.getConfig(CONFIG_BOOL_GRID_PRELOAD))
+        m_gridPreloader.activate();
 }
 
 void MapManager::InitStateMachine()
@@ -195,16 +199,29 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
-    for (auto& map : i_maps)
+    if (m_updater.activated())
     {
-        if (m_updater.activated())
-            m_updater.schedule_update(new MapUpdateWorker(*map.second, (uint32)i_timer.GetCurrent(), m_updater));
-        else
-            map.second->Update((uint32)i_timer.GetCurrent());
-    }
+        // most expensive maps first, cheap instances fill up the threads at the end of the tick
+        std::vector<Map*> maps;
+        maps.reserve(i_maps.size());
+        for (auto& map : i_maps)
+            maps.push_back(map.second);
+
+        std::stable_sort(maps.begin(), maps.end(), [](Map const* left, Map const* right)
+        {
+            return left->GetLastUpdateDuration() > right->GetLastUpdateDuration();
+        });
+
+        for (Map* map : maps)
+            m_updater.schedule_update(new MapUpdateWorker(*map, (uint32)i_timer.GetCurrent(), m_updater), map->GetLastUpdateDuration());
 
-    if (m_updater.activated())
         m_updater.wait();
+    }
+    else
+    {
+        for (auto& map : i_maps)
+            map.second->Update((uint32)i_timer.GetCurrent());
+    }
 
     // remove all maps which can be unloaded
     MapMapType::iterator iter = i_maps.begin();
@@ -263,6 +280,8 @@ void MapManager::UnloadAll()
     if (m_updater.activated())
         m_updater.deactivate();
 
+    m_gridPreloader.deactivate();
+
     TerrainManager::Instance().UnloadAll();
 }
 
@@ -26,6 +26,7 @@
 #include "Maps/Map.h"
 #include "Grids/GridStates.h"
 #include "Maps/MapUpdater.h"
+#include "Maps/GridPreloader.h"
 
 #include <functional>
 
@@ -135,6 +136,9 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         void RemoveAllObjectsInRemoveList();
 
+        MapUpdater& GetMapUpdater() { return m_updater; }
+        GridPreloader& GetGridPreloader() { return m_gridPreloader; }
+
         void LoadTransports();
 
         typedef std::map<uint32, std::vector<const TransportTemplate*>> TransportMap;
@@ -188,6 +192,7 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         IntervalTimer i_timer;
 
         MapUpdater m_updater;
+        GridPreloader m_gridPreloader;
 };
 
 template<typename Do>
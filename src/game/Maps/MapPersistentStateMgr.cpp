@@ -71,6 +71,12 @@ bool MapPersistentState::UnloadIfEmpty()
 
 void MapPersistentState::SaveCreatureRespawnTime(uint32 loguid, time_t t)
 {
+    if (m_usedByMap && m_usedByMap->IsUpdatingInParallel())
+    {
+        m_usedByMap->ExecuteSerialized([loguid, t](Map* map) { map->GetPersistentState()->SaveCreatureRespawnTime(loguid, t); });
+        return;
+    }
+
     SetCreatureRespawnTime(loguid, t);
 
     // BGs/Arenas always reset at server restart/unload, so no reason store in DB
@@ -96,6 +102,12 @@ void MapPersistentState::SaveCreatureRespawnTime(uint32 loguid, time_t t)
 
 void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
 {
+    if (m_usedByMap && m_usedByMap->IsUpdatingInParallel())
+    {
+        m_usedByMap->ExecuteSerialized([loguid, t](Map* map) { map->GetPersistentState()->SaveGORespawnTime(loguid, t); });
+        return;
+    }
+
     SetGORespawnTime(loguid, t);
 
     // BGs/Arenas always reset at server restart/unload, so no reason store in DB
@@ -134,6 +146,9 @@ void MapPersistentState::SaveObjectRespawnTime(uint32 typeId, uint32 loguid, tim
 
 void MapPersistentState::SetCreatureRespawnTime(uint32 loguid, time_t t)
 {
+    // respawn times are map wide, region workers have to go through SaveCreatureRespawnTime
+    MANGOS_ASSERT(!m_usedByMap || !m_usedByMap->IsUpdatingInParallel());
+
     if (t > sWorld.GetGameTime())
         m_creatureRespawnTimes[loguid] = t;
     else
@@ -145,6 +160,9 @@ void MapPersistentState::SetCreatureRespawnTime(uint32 loguid, time_t t)
 
 void MapPersistentState::SetGORespawnTime(uint32 loguid, time_t t)
 {
+    // respawn times are map wide, region workers have to go through SaveGORespawnTime
+    MANGOS_ASSERT(!m_usedByMap || !m_usedByMap->IsUpdatingInParallel());
+
     if (t > sWorld.GetGameTime())
         m_goRespawnTimes[loguid] = t;
     else
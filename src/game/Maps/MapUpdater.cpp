@@ -19,10 +19,27 @@
 #include "MapUpdater.h"
 #include "MapWorkers.h"
 
-MapUpdater::MapUpdater(size_t num_threads) : _cancelationToken(false), pending_requests(0)
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+namespace
 {
-    for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+    // queue owned by the current thread, only set for pool threads
+    thread_local MapUpdater const* s_currentUpdater = nullptr;
+    thread_local size_t s_currentQueue = 0;
+}
+
+MapUpdater::MapUpdater(size_t num_threads) : _cancelationToken(false), pending_requests(0), queued_requests(0)
+{
+    activate(num_threads);
+}
+
+MapUpdater::~MapUpdater()
+{
+    for (auto& queue : _queues)
+        for (auto& worker : queue->workers)
+            delete worker.first;
 }
 
 void MapUpdater::activate(size_t num_threads)
@@ -31,14 +48,20 @@ void MapUpdater::activate(size_t num_threads)
         return;
 
     for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _queues.push_back(std::make_unique<WorkerQueue>());
+
+    for (size_t i = 0; i < num_threads; ++i)
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
 }
 
 void MapUpdater::deactivate()
 {
     _cancelationToken = true;
 
-    _queue.Cancel();
+    {
+        std::lock_guard<std::mutex> lock(_sleepLock);
+        _sleepCondition.notify_all();
+    }
 
     for (auto& thread : _workerThreads)
         thread.join();
@@ -71,30 +94,134 @@ void MapUpdater::update_finished()
     _condition.notify_all();
 }
 
-void MapUpdater::schedule_update(Worker* worker)
+void MapUpdater::schedule_update(Worker* worker, uint64 cost)
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        ++pending_requests;
+    }
 
-    ++pending_requests;
-    _queue.Push(std::move(worker));
+    // work spawned by a pool thread stays local, the back of the queue is where idle threads steal from first
+    if (s_currentUpdater == this)
+    {
+        push(s_currentQueue, worker, cost);
+        return;
+    }
+
+    size_t best = 0;
+    uint64 bestCost = std::numeric_limits<uint64>::max();
+    for (size_t i = 0; i < _queues.size(); ++i)
+    {
+        uint64 queueCost = _queues[i]->cost;
+        if (queueCost < bestCost)
+        {
+            best = i;
+            bestCost = queueCost;
+        }
+    }
+
+    push(best, worker, cost);
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::execute_batch(std::vector<Worker*>& workers)
 {
-    while (true)
+    if (workers.empty())
+        return;
+
+    std::shared_ptr<WorkerBatch> batch = std::make_shared<WorkerBatch>(workers);
+    workers.clear();
+
+    // helpers only pick up batch entries which were not claimed yet, so a helper dequeued late is a no-op
+    size_t helpers = std::min(batch->size() - 1, _workerThreads.size());
+    for (size_t i = 0; i < helpers; ++i)
+        schedule_update(new BatchHelperWorker(batch, *this));
+
+    while (batch->ExecuteNext()) {}
+
+    batch->Wait();
+}
+
+void MapUpdater::push(size_t index, Worker* worker, uint64 cost)
+{
+    // unknown cost still counts, so that new maps spread over the queues
+    cost = std::max<uint64>(cost, 1);
+
+    WorkerQueue& queue = *_queues[index];
     {
-        Worker* request = nullptr;
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.workers.emplace_back(worker, cost);
+        queue.cost += cost;
+    }
+
+    ++queued_requests;
+
+    std::lock_guard<std::mutex> lock(_sleepLock);
+    _sleepCondition.notify_one();
+}
 
-        _queue.WaitAndPop(request);
+Worker* MapUpdater::take(size_t index)
+{
+    // own queue from the front, the others from the back
+    for (size_t i = 0; i < _queues.size(); ++i)
+    {
+        WorkerQueue& queue = *_queues[(index + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (queue.workers.empty())
+            continue;
+
+        std::pair<Worker*, uint64> worker;
+        if (i == 0)
+        {
+            worker = queue.workers.front();
+            queue.workers.pop_front();
+        }
+        else
+        {
+            worker = queue.workers.back();
+            queue.workers.pop_back();
+        }
+        queue.cost -= worker.second;
+        return worker.first;
+    }
 
+    return nullptr;
+}
+
+bool MapUpdater::claim()
+{
+    size_t queued = queued_requests;
+    while (true)
+    {
         if (_cancelationToken)
+            return false;
+
+        if (queued > 0)
         {
-            delete request;
-            return;
+            if (queued_requests.compare_exchange_weak(queued, queued - 1))
+                return true;
+            continue;
         }
 
+        std::unique_lock<std::mutex> lock(_sleepLock);
+        _sleepCondition.wait(lock, [this] { return _cancelationToken || queued_requests > 0; });
+        queued = queued_requests;
+    }
+}
+
+void MapUpdater::WorkerThread(size_t index)
+{
+    s_currentUpdater = this;
+    s_currentQueue = index;
+
+    while (claim())
+    {
+        // a claimed worker is guaranteed to be in one of the queues, it is pushed before being counted
+        Worker* request = nullptr;
+        while (!(request = take(index)))
+            std::this_thread::yield();
+
         request->execute();
 
         delete request;
     }
-}
\ No newline at end of file
+}
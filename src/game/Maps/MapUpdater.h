@@ -20,34 +20,52 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Platform/Define.h"
-#include "Util/ProducerConsumerQueue.h"
 
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <condition_variable>
 
 class Worker;
 
+// every pool thread owns a queue, idle threads steal from the back of the other queues
+// maps are spread over the queues by their estimated update cost (see MapManager::Update)
 class MapUpdater
 {
     public:
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
+        MapUpdater() : _cancelationToken(false), pending_requests(0), queued_requests(0) {}
         MapUpdater(size_t num_threads);
         MapUpdater(const MapUpdater&) = delete;
-        
+        ~MapUpdater();
+
         void activate(size_t num_threads);
         void deactivate();
         void wait();
         void join();
         bool activated();
         void update_finished();
-        void schedule_update(Worker* worker);
+        // cost is an estimate of the execution time, used to balance the thread queues
+        void schedule_update(Worker* worker, uint64 cost = 0);
+
+        // runs all workers on the pool, the calling thread takes part so this is safe to use from within a worker
+        // returns once every worker of the batch finished - takes ownership of the workers
+        void execute_batch(std::vector<Worker*>& workers);
+        size_t thread_count() const { return _workerThreads.size(); }
 
     private:
-        ProducerConsumerQueue<Worker *> _queue;
+        struct WorkerQueue
+        {
+            WorkerQueue() : cost(0) {}
 
+            std::mutex lock;
+            std::deque<std::pair<Worker*, uint64>> workers;
+            std::atomic<uint64> cost;                       // sum of the estimated cost of all queued workers
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> _queues;
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
 
@@ -55,7 +73,15 @@ class MapUpdater
         std::condition_variable _condition;
         size_t pending_requests;
 
-        void WorkerThread();
+        // number of queued workers not yet claimed by a thread, threads sleep while it is 0
+        std::atomic<size_t> queued_requests;
+        std::mutex _sleepLock;
+        std::condition_variable _sleepCondition;
+
+        void push(size_t index, Worker* worker, uint64 cost);
+        Worker* take(size_t index);
+        bool claim();
+        void WorkerThread(size_t index);
 };
 
-#endif //_MAP_UPDATER_H_INCLUDED
\ No newline at end of file
+#endif //_MAP_UPDATER_H_INCLUDED
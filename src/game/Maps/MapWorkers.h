@@ -24,7 +24,16 @@
 #include "MapUpdater.h"
 #include "MotionGenerators/MovementGenerator.h"
 #include "Entities/Object.h"
+#include "Entities/UpdateData.h"
+#include "Server/WorldPacket.h"
 #include "Platform/Define.h"
+#include "Util/Timer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 class Worker
 {
@@ -49,7 +58,9 @@ class MapUpdateWorker : public Worker
 
         void execute() override
         {
+            uint32 startTime = WorldTimer::getMSTime();
             m_map.Update(m_diff);
+            m_map.SetLastUpdateDuration(WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
             GetWorker().update_finished();
         }
 
@@ -58,6 +69,66 @@ class MapUpdateWorker : public Worker
         uint32 m_diff;
 };
 
+// workers below are executed through MapUpdater::execute_batch which accounts for them as a whole
+class WorkerBatch
+{
+    public:
+        explicit WorkerBatch(std::vector<Worker*>& workers) : m_workers(std::move(workers)), m_next(0), m_finished(0) {}
+
+        size_t size() const { return m_workers.size(); }
+
+        // claims and executes the next not yet started worker, returns false once all of them are claimed
+        bool ExecuteNext()
+        {
+            size_t index = m_next.fetch_add(1);
+            if (index >= m_workers.size())
+                return false;
+
+            m_workers[index]->execute();
+            delete m_workers[index];
+            m_workers[index] = nullptr;
+
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (++m_finished == m_workers.size())
+                m_condition.notify_all();
+            return true;
+        }
+
+        void Wait()
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+
+            while (m_finished < m_workers.size())
+                m_condition.wait(lock);
+        }
+
+    private:
+        std::vector<Worker*> m_workers;
+        std::atomic<size_t> m_next;
+        size_t m_finished;
+
+        std::mutex m_lock;
+        std::condition_variable m_condition;
+};
+
+class BatchHelperWorker : public Worker
+{
+    public:
+        BatchHelperWorker(std::shared_ptr<WorkerBatch> batch, MapUpdater& updater) :
+            Worker(updater), m_batch(std::move(batch))
+        {}
+
+        void execute() override
+        {
+            while (m_batch->ExecuteNext()) {}
+
+            GetWorker().update_finished();
+        }
+
+    private:
+        std::shared_ptr<WorkerBatch> m_batch;
+};
+
 class GridCrawler : public Worker
 {
     public:
@@ -78,7 +149,8 @@ class GridCrawler : public Worker
                 m_map.Visit(cell, world_object_update);
             }
 
-            GetWorker().update_finished();
+            for (WorldObject* object : objToUpdate)
+                object->Update(m_diff);
         }
 
     private:
@@ -87,25 +159,69 @@ class GridCrawler : public Worker
         uint32 m_diff;
 };
 
-
+// updates one region of a map, see Map::UpdateObjectsInParallel
 class ObjectUpdateWorker : public Worker
 {
     public:
-        ObjectUpdateWorker(std::unordered_set<WorldObject*>& objects, uint32 diff, MapUpdater& updater) :
-            Worker(updater), m_objects(objects), m_diff(diff)
+        ObjectUpdateWorker(std::vector<WorldObject*>&& objects, uint32 diff, MapUpdater& updater) :
+            Worker(updater), m_objects(std::move(objects)), m_diff(diff)
         {}
 
         void execute() override
         {
-            for (WorldObject* const &object : m_objects)
+            for (WorldObject* object : m_objects)
                 object->Update(m_diff);
-
-            GetWorker().update_finished();
         }
 
     private:
-        std::unordered_set<WorldObject*>& m_objects;
+        std::vector<WorldObject*> m_objects;
         uint32 m_diff;
 };
 
+// builds the update data of a part of the dirty objects of a map, see Map::SendObjectUpdatesInParallel
+class UpdateDataBuildWorker : public Worker
+{
+    public:
+        UpdateDataBuildWorker(std::vector<Object*>&& objects, UpdateDataMapType& updatePlayers, MapUpdater& updater) :
+            Worker(updater), m_objects(std::move(objects)), m_updatePlayers(updatePlayers)
+        {}
+
+        void execute() override
+        {
+            for (Object* object : m_objects)
+                object->BuildUpdateData(m_updatePlayers);
+        }
+
+    private:
+        std::vector<Object*> m_objects;
+        UpdateDataMapType& m_updatePlayers;
+};
+
+// builds (and compresses) the update packets of a range of receivers
+class UpdatePacketBuildWorker : public Worker
+{
+    public:
+        UpdatePacketBuildWorker(std::vector<std::pair<Player*, UpdateData*>>& receivers, std::vector<std::vector<WorldPacket>>& packets,
+                                size_t begin, size_t end, MapUpdater& updater) :
+            Worker(updater), m_receivers(receivers), m_packets(packets), m_begin(begin), m_end(end)
+        {}
+
+        void execute() override
+        {
+            for (size_t i = m_begin; i < m_end; ++i)
+            {
+                UpdateData& data = *m_receivers[i].second;
+                m_packets[i].reserve(data.GetPacketCount());
+                for (size_t k = 0; k < data.GetPacketCount(); ++k)
+                    m_packets[i].push_back(data.BuildPacket(k));
+            }
+        }
+
+    private:
+        std::vector<std::pair<Player*, UpdateData*>>& m_receivers;
+        std::vector<std::vector<WorldPacket>>& m_packets;
+        size_t m_begin;
+        size_t m_end;
+};
+
 #endif //_MAP_WORKERS_H_INCLUDED
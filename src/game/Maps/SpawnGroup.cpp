@@ -413,6 +413,13 @@ void CreatureGroup::RemoveObject(WorldObject* wo)
 
 void CreatureGroup::TriggerLinkingEvent(uint32 event, Unit* target)
 {
+    // members can be spread over several regions of a parallel update, handle the event once the pass finished
+    if (m_map.IsUpdatingInParallel())
+    {
+        m_map.ExecuteSerialized([this, event, target](Map*) { TriggerLinkingEvent(event, target); });
+        return;
+    }
+
     switch (event)
     {
         case CREATURE_GROUP_EVENT_AGGRO:
@@ -107,6 +107,12 @@ void SpawnManager::Initialize()
 
 void SpawnManager::AddCreature(uint32 dbguid)
 {
+    if (m_map.IsUpdatingInParallel())
+    {
+        m_map.ExecuteSerialized([dbguid](Map* map) { map->GetSpawnManager().AddCreature(dbguid); });
+        return;
+    }
+
     time_t respawnTime = m_map.GetPersistentState()->GetCreatureRespawnTime(dbguid);
     if (m_updated)
         m_deferredSpawns.emplace_back(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_UNIT);
@@ -116,6 +122,12 @@ void SpawnManager::AddCreature(uint32 dbguid)
 
 void SpawnManager::AddGameObject(uint32 dbguid)
 {
+    if (m_map.IsUpdatingInParallel())
+    {
+        m_map.ExecuteSerialized([dbguid](Map* map) { map->GetSpawnManager().AddGameObject(dbguid); });
+        return;
+    }
+
     time_t respawnTime = m_map.GetPersistentState()->GetGORespawnTime(dbguid);
     if (m_updated)
         m_deferredSpawns.emplace_back(TimePoint(std::chrono::seconds(respawnTime)), dbguid, HIGHGUID_GAMEOBJECT);
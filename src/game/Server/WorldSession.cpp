@@ -274,6 +274,8 @@ void WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
 
         if (new_packet->rpos() < new_packet->wpos() && sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
             LogUnprocessedTail(*new_packet);
+
+        WorldSocket::ReleasePacket(std::move(new_packet));
         return;
     }
 
@@ -353,6 +355,9 @@ void WorldSession::ProcessByteBufferException(WorldPacket const& packet)
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(uint32 /*diff*/)
 {
+    // database requests of the account stay ordered with the ones queued by map threads
+    SqlOwnerScope ownerScope(GetAccountId());
+
     GetMessager().Execute(this);
 
     std::deque<std::unique_ptr<WorldPacket>> recvQueueCopy;
@@ -374,7 +379,7 @@ bool WorldSession::Update(uint32 /*diff*/)
     {
         // sLog.outError("MOEP: %s (0x%.4X)", packet->GetOpcodeName(), packet->GetOpcode());
 
-        auto const packet = std::move(recvQueueCopy.front());
+        std::unique_ptr<WorldPacket> packet = std::move(recvQueueCopy.front());
         recvQueueCopy.pop_front();
 
         OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
@@ -445,6 +450,8 @@ bool WorldSession::Update(uint32 /*diff*/)
                               packet->GetOpcode());
                 break;
         }
+
+        WorldSocket::ReleasePacket(std::move(packet));
     }
 
 #ifdef BUILD_DEPRECATED_PLAYERBOT
@@ -560,6 +567,8 @@ bool WorldSession::Update(uint32 /*diff*/)
 
 void WorldSession::UpdateMap(uint32 diff)
 {
+    SqlOwnerScope ownerScope(GetAccountId());
+
     std::deque<std::unique_ptr<WorldPacket>> recvQueueMapCopy;
     {
         std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
@@ -568,7 +577,7 @@ void WorldSession::UpdateMap(uint32 diff)
 
     while (m_socket && !m_socket->IsClosed() && recvQueueMapCopy.size())
     {
-        auto const packet = std::move(recvQueueMapCopy.front());
+        std::unique_ptr<WorldPacket> packet = std::move(recvQueueMapCopy.front());
         recvQueueMapCopy.pop_front();
 
         OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
@@ -577,12 +586,16 @@ void WorldSession::UpdateMap(uint32 diff)
         {
             ExecuteOpcode(opHandle, *packet);
         }
+
+        WorldSocket::ReleasePacket(std::move(packet));
     }
 }
 
 /// %Log the player out
 void WorldSession::LogoutPlayer()
 {
+    SqlOwnerScope ownerScope(GetAccountId());
+
     // if the player has just logged out, there is no need to do anything here
     if (m_playerRecentlyLogout)
         return;
@@ -34,6 +34,7 @@
 #include "Util/CommonDefines.h"
 #include "Anticheat/Anticheat.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #include <memory>
@@ -104,7 +105,45 @@ std::vector<uint32> InitOpcodeCooldowns()
     return data;
 }
 
+std::vector<uint8> InitOpcodeCooldownSlots(std::vector<uint32> const& cooldowns)
+{
+    std::vector<uint8> slots(cooldowns.size(), 0);
+
+    uint8 slot = 0;
+    for (size_t i = 0; i < cooldowns.size(); ++i)
+        if (cooldowns[i])
+            slots[i] = slot++;
+
+    return slots;
+}
+
 std::vector<uint32> WorldSocket::m_packetCooldowns = InitOpcodeCooldowns();
+std::vector<uint8> WorldSocket::m_packetCooldownSlots = InitOpcodeCooldownSlots(WorldSocket::m_packetCooldowns);
+
+std::mutex WorldSocket::m_packetPoolMutex;
+std::vector<std::unique_ptr<WorldPacket>> WorldSocket::m_packetPool;
+
+std::atomic<uint64> WorldSocket::m_sendWriteCount(0);
+std::atomic<uint64> WorldSocket::m_sendByteCount(0);
+std::atomic<uint64> WorldSocket::m_sendMaxQueuedBytes(0);
+
+// sent packet buffers larger than this are released after the write instead of being reused
+#define WORLD_SOCKET_SENT_PACKET_KEEP_SIZE (4 * 1024)
+// written packet entries kept per socket with their buffer, the rest is freed after each write
+#define WORLD_SOCKET_SENT_PACKET_KEEP_COUNT 8
+// received packets larger than this are not returned to the pool
+#define WORLD_SOCKET_QUEUED_PACKET_KEEP_SIZE (16 * 1024)
+
+// receive buffer size, bodies of packets not fitting into it are received directly into the packet
+#define WORLD_SOCKET_RECEIVE_BUFFER_SIZE 4096
+// received packets kept for reuse by all sockets together
+#define WORLD_SOCKET_PACKET_POOL_SIZE 4096
+// received packets kept by each thread, only full batches move between a thread and the shared pool
+#define WORLD_SOCKET_PACKET_CACHE_SIZE 64
+#define WORLD_SOCKET_PACKET_CACHE_BATCH 32
+
+// packets are acquired by the network threads and released by the world and map threads
+static thread_local std::vector<std::unique_ptr<WorldPacket>> t_packetCache;
 
 std::deque<uint32> WorldSocket::GetOutOpcodeHistory()
 {
@@ -119,8 +158,49 @@ std::deque<uint32> WorldSocket::GetIncOpcodeHistory()
 }
 
 WorldSocket::WorldSocket(boost::asio::io_service& service) : AsyncSocket(service), m_lastPingTime(std::chrono::system_clock::time_point::min()), m_overSpeedPings(0),
-    m_session(nullptr), m_seed(urand()), m_loggingPackets(false)
+    m_session(nullptr), m_seed(urand()), m_readBuffer(WORLD_SOCKET_RECEIVE_BUFFER_SIZE), m_readBufferSize(0), m_pendingPacketReceived(0),
+    m_flushPending(false), m_outPacketCount(0), m_sendPacketCount(0), m_outBytes(0), m_writeInProgress(false), m_loggingPackets(false),
+    m_lastPacket(std::count_if(m_packetCooldowns.begin(), m_packetCooldowns.end(), [](uint32 cooldown) { return cooldown != 0; }))
+{
+}
+
+std::unique_ptr<WorldPacket> WorldSocket::AcquirePacket(uint16 opcode, size_t size)
+{
+    if (t_packetCache.empty())
+    {
+        std::lock_guard<std::mutex> guard(m_packetPoolMutex);
+        size_t count = std::min<size_t>(m_packetPool.size(), WORLD_SOCKET_PACKET_CACHE_BATCH);
+        std::move(m_packetPool.end() - count, m_packetPool.end(), std::back_inserter(t_packetCache));
+        m_packetPool.resize(m_packetPool.size() - count);
+    }
+
+    if (t_packetCache.empty())
+        return std::make_unique<WorldPacket>(static_cast<Opcodes>(opcode), size);
+
+    std::unique_ptr<WorldPacket> packet = std::move(t_packetCache.back());
+    t_packetCache.pop_back();
+
+    packet->Initialize(static_cast<Opcodes>(opcode), size);
+    packet->SetReceivedTime(std::chrono::steady_clock::time_point());
+    return packet;
+}
+
+void WorldSocket::ReleasePacket(std::unique_ptr<WorldPacket> packet)
 {
+    // only keep buffers of usual packet sizes
+    if (!packet || packet->capacity() > WORLD_SOCKET_QUEUED_PACKET_KEEP_SIZE)
+        return;
+
+    if (t_packetCache.size() >= WORLD_SOCKET_PACKET_CACHE_SIZE)
+    {
+        std::lock_guard<std::mutex> guard(m_packetPoolMutex);
+        size_t count = std::min<size_t>(WORLD_SOCKET_PACKET_POOL_SIZE - std::min<size_t>(m_packetPool.size(), WORLD_SOCKET_PACKET_POOL_SIZE), WORLD_SOCKET_PACKET_CACHE_BATCH);
+        std::move(t_packetCache.end() - count, t_packetCache.end(), std::back_inserter(m_packetPool));
+        // a full shared pool drops the rest of the batch
+        t_packetCache.resize(t_packetCache.size() - WORLD_SOCKET_PACKET_CACHE_BATCH);
+    }
+
+    t_packetCache.push_back(std::move(packet));
 }
 
 void WorldSocket::SendPacket(const WorldPacket& pct, bool immediate)
@@ -134,33 +214,121 @@ void WorldSocket::SendPacket(const WorldPacket& pct, bool immediate)
     // Dump outgoing packet.
     sLog.outWorldPacketDump(GetRemoteEndpoint().c_str(), pct.GetOpcode(), pct.GetOpcodeName(), pct, false);
 
-    // encrypt thread unsafe due to being executed from map contexts frequently - TODO: move to post service context in future
-    std::lock_guard<std::mutex> guard(m_worldSocketMutex);
+    m_outQueue.Push([&pct](OutgoingPacket& packet)
+    {
+        packet.opcode = pct.GetOpcode();
+        packet.payload.assign(pct.contents(), pct.contents() + pct.size());
+    });
 
-    ServerPktHeader header(pct.size() + 2, pct.GetOpcode());
-    m_crypt.EncryptSend(static_cast<uint8*>(header.header), header.headerSize());
+    // header encryption is not thread safe and depends on packet order, it is done in the socket strand
+    if (!m_flushPending.exchange(true))
+    {
+        auto self(shared_from_this());
+        Post([self]() { self->FlushOutgoing(); });
+    }
+}
 
-    uint32 opcode = pct.GetOpcode();
+void WorldSocket::FlushOutgoing()
+{
+    // cleared first, packets queued from now on schedule another flush
+    m_flushPending = false;
 
-    m_opcodeHistoryOut.push_front(uint32(opcode));
-    if (m_opcodeHistoryOut.size() > 50)
-        m_opcodeHistoryOut.resize(30);
+    size_t firstPacket = m_outPacketCount;
+    m_outQueue.ConsumeAll([this](OutgoingPacket& packet)
+    {
+        if (m_outPacketCount == m_outPackets.size())
+            m_outPackets.emplace_back();
+
+        // the payload is not copied, the queue node takes over the (cleared) buffer of an already written packet
+        OutgoingPacket& out = m_outPackets[m_outPacketCount++];
+        out.opcode = packet.opcode;
+        out.payload.swap(packet.payload);
+
+        // headers are encrypted in the order the packets are written, the crypt state advances with each one
+        ServerPktHeader header(out.payload.size() + 2, out.opcode);
+        out.headerSize = uint8(header.headerSize());
+        memcpy(out.header, header.header, out.headerSize);
+        m_crypt.EncryptSend(out.header, out.headerSize);
+        m_outBytes += out.headerSize + out.payload.size();
+    });
 
-    if (pct.size() > 0)
+    if (firstPacket == m_outPacketCount)
+        return;
+
+    // the history is read by other threads, everything else here is only used from the strand
     {
-        // allocate array for full message
-        std::shared_ptr<std::vector<char>> fullMessage = std::make_shared<std::vector<char>>(header.headerSize() + pct.size());
-        std::memcpy(fullMessage->data(), header.data(), header.headerSize()); // copy header
-        std::memcpy((fullMessage->data() + header.headerSize()), reinterpret_cast<const char*>(pct.contents()), pct.size()); // copy packet
-        auto self(shared_from_this());
-        Write(fullMessage->data(), fullMessage->size(), [self, fullMessage](const boost::system::error_code& error, std::size_t read) {});
+        std::lock_guard<std::mutex> guard(m_worldSocketMutex);
+        for (size_t i = firstPacket; i < m_outPacketCount; ++i)
+            m_opcodeHistoryOut.push_front(uint32(m_outPackets[i].opcode));
+        if (m_opcodeHistoryOut.size() > 50)
+            m_opcodeHistoryOut.resize(30);
     }
-    else
+
+    uint64 queued = m_outBytes;
+    uint64 maxQueued = m_sendMaxQueuedBytes;
+    while (queued > maxQueued && !m_sendMaxQueuedBytes.compare_exchange_weak(maxQueued, queued)) {}
+
+    if (!m_writeInProgress)
+        StartWrite();
+}
+
+void WorldSocket::StartWrite()
+{
+    m_sendPackets.swap(m_outPackets);
+    std::swap(m_sendPacketCount, m_outPacketCount);
+    m_writeInProgress = true;
+
+    m_sendBuffers.clear();
+    for (size_t i = 0; i < m_sendPacketCount; ++i)
     {
-        std::shared_ptr<ServerPktHeader> sharedHeader = std::make_shared<ServerPktHeader>(header);
-        auto self(shared_from_this());
-        Write(sharedHeader->data(), sharedHeader->headerSize(), [self, sharedHeader](const boost::system::error_code& error, std::size_t read) {});
+        OutgoingPacket const& packet = m_sendPackets[i];
+        m_sendBuffers.emplace_back(packet.header, packet.headerSize);
+        if (!packet.payload.empty())
+            m_sendBuffers.emplace_back(packet.payload.data(), packet.payload.size());
     }
+
+    ++m_sendWriteCount;
+    m_sendByteCount += m_outBytes;
+    m_outBytes = 0;
+
+    auto self(shared_from_this());
+    Write(m_sendBuffers, [self](const boost::system::error_code& error, std::size_t /*written*/)
+    {
+        self->HandleWriteComplete(error);
+    });
+}
+
+void WorldSocket::HandleWriteComplete(const boost::system::error_code& error)
+{
+    // keep a few entries for the next packets unless a burst left unusually large buffers behind
+    for (size_t i = 0; i < m_sendPacketCount; ++i)
+    {
+        std::vector<uint8>& payload = m_sendPackets[i].payload;
+        payload.clear();
+        if (payload.capacity() > WORLD_SOCKET_SENT_PACKET_KEEP_SIZE)
+            payload.shrink_to_fit();
+    }
+    if (m_sendPackets.size() > WORLD_SOCKET_SENT_PACKET_KEEP_COUNT)
+    {
+        m_sendPackets.resize(WORLD_SOCKET_SENT_PACKET_KEEP_COUNT);
+        m_sendPackets.shrink_to_fit();
+    }
+    m_sendPacketCount = 0;
+
+    m_writeInProgress = false;
+
+    if (error)
+        return;
+
+    if (m_outPacketCount)
+        StartWrite();
+}
+
+void WorldSocket::ConsumeSendStatistics(uint64& writes, uint64& bytes, uint64& maxQueuedBytes)
+{
+    writes = m_sendWriteCount.exchange(0);
+    bytes = m_sendByteCount.exchange(0);
+    maxQueuedBytes = m_sendMaxQueuedBytes.exchange(0);
 }
 
 bool WorldSocket::OnOpen()
@@ -185,119 +353,176 @@ bool WorldSocket::OnOpen()
 
 bool WorldSocket::ProcessIncomingData()
 {
-    std::shared_ptr<ClientPktHeader> header = std::make_shared<ClientPktHeader>();
-
     auto self(shared_from_this());
-    Read((char*)header.get(), sizeof(ClientPktHeader), [self, header](const boost::system::error_code& error, std::size_t read) -> void
+
+    if (m_pendingPacket)
+    {
+        Read(reinterpret_cast<char*>(m_pendingPacket->contents() + m_pendingPacketReceived), m_pendingPacket->size() - m_pendingPacketReceived, [self](const boost::system::error_code& error, std::size_t /*read*/) -> void
+        {
+            if (error) return;
+
+            // thread safe due to always being called from service context
+            self->m_pendingPacketReceived = 0;
+            if (self->ProcessPacket(std::move(self->m_pendingPacket)))
+                self->ProcessIncomingData();
+        });
+        return true;
+    }
+
+    ReadSome(reinterpret_cast<char*>(m_readBuffer.data() + m_readBufferSize), m_readBuffer.size() - m_readBufferSize, [self](const boost::system::error_code& error, std::size_t read) -> void
     {
         if (error) return;
+
         // thread safe due to always being called from service context
-        self->m_crypt.DecryptRecv((uint8*)header.get(), sizeof(ClientPktHeader));
+        self->m_readBufferSize += read;
+        if (self->ProcessReceivedData())
+            self->ProcessIncomingData();
+    });
+
+    return true;
+}
 
-        EndianConvertReverse(header->size);
-        EndianConvert(header->cmd);
+bool WorldSocket::ProcessReceivedData()
+{
+    size_t pos = 0;
+    while (m_readBufferSize - pos >= sizeof(ClientPktHeader))
+    {
+        // headers are decrypted one at a time, processing the previous packet can initialize the crypt
+        ClientPktHeader header;
+        m_crypt.DecryptRecv(m_readBuffer.data() + pos, sizeof(ClientPktHeader));
+        memcpy(&header, m_readBuffer.data() + pos, sizeof(ClientPktHeader));
+        pos += sizeof(ClientPktHeader);
 
-        if ((header->size < 4) || (header->size > 0x2800) || (header->cmd >= NUM_MSG_TYPES))
+        EndianConvertReverse(header.size);
+        EndianConvert(header.cmd);
+
+        if ((header.size < 4) || (header.size > 0x2800) || (header.cmd >= NUM_MSG_TYPES))
         {
-            sLog.outError("WorldSocket::ProcessIncomingData: client sent malformed packet size = %u , cmd = %u", header->size, header->cmd);
-            return;
+            sLog.outError("WorldSocket::ProcessIncomingData: client sent malformed packet size = %u , cmd = %u", header.size, header.cmd);
+            return false;
         }
 
-        const Opcodes opcode = static_cast<Opcodes>(header->cmd);
+        // the body is written into the packet once, the part not received yet is read straight into it
+        size_t packetSize = header.size - 4;
+        size_t available = std::min(packetSize, m_readBufferSize - pos);
+        std::unique_ptr<WorldPacket> pct = AcquirePacket(uint16(header.cmd), packetSize);
+        pct->resize(packetSize);
+        if (available)
+            memcpy(pct->contents(), m_readBuffer.data() + pos, available);
+        pos += available;
 
-        size_t packetSize = header->size - 4;
-        std::shared_ptr<std::vector<uint8>> packetBuffer = std::make_shared<std::vector<uint8>>(packetSize);
-
-        self->Read(reinterpret_cast<char*>(packetBuffer->data()), packetBuffer->size(), [self, packetBuffer, opcode = opcode](const boost::system::error_code& error, std::size_t read) -> void
+        if (available < packetSize)
         {
-            if (error) return;
-            std::unique_ptr<WorldPacket> pct = std::make_unique<WorldPacket>(opcode, packetBuffer->size());
-            pct->append(*packetBuffer.get());
-            if (sPacketLog->CanLogPacket() && self->IsLoggingPackets())
-                sPacketLog->LogPacket(*pct, CLIENT_TO_SERVER, self->GetRemoteIpAddress(), self->GetRemotePort());
+            m_pendingPacket = std::move(pct);
+            m_pendingPacketReceived = available;
+            break;
+        }
 
-            sLog.outWorldPacketDump(self->GetRemoteEndpoint().c_str(), pct->GetOpcode(), pct->GetOpcodeName(), *pct, true);
+        if (!ProcessPacket(std::move(pct)))
+            return false;
+    }
 
-            if (WorldSocket::m_packetCooldowns.size() <= size_t(opcode))
-            {
-                sLog.outError("WorldSocket::ProcessIncomingData: Received opcode beyond range of opcodes: %u", opcode);
-                return;
-            }
+    // keep an incomplete header at the front
+    if (pos)
+    {
+        m_readBufferSize -= pos;
+        memmove(m_readBuffer.data(), m_readBuffer.data() + pos, m_readBufferSize);
+    }
 
-            if (WorldSocket::m_packetCooldowns[opcode])
-            {
-                auto now = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
-                if (now < self->m_lastPacket[opcode]) // packet on cooldown
-                {
-                    self->ProcessIncomingData();
-                    return;
-                }
-                else // start cooldown and allow execution
-                    self->m_lastPacket[opcode] = now + std::chrono::milliseconds(WorldSocket::m_packetCooldowns[opcode]);
-            }
+    return true;
+}
 
-            try
-            {
-                switch (opcode)
+bool WorldSocket::ProcessPacket(std::unique_ptr<WorldPacket> pct)
+{
+    const Opcodes opcode = pct->GetOpcode();
+
+    if (sPacketLog->CanLogPacket() && IsLoggingPackets())
+        sPacketLog->LogPacket(*pct, CLIENT_TO_SERVER, GetRemoteIpAddress(), GetRemotePort());
+
+    sLog.outWorldPacketDump(GetRemoteEndpoint().c_str(), pct->GetOpcode(), pct->GetOpcodeName(), *pct, true);
+
+    if (WorldSocket::m_packetCooldowns.size() <= size_t(opcode))
+    {
+        sLog.outError("WorldSocket::ProcessIncomingData: Received opcode beyond range of opcodes: %u", opcode);
+        return false;
+    }
+
+    if (WorldSocket::m_packetCooldowns[opcode])
+    {
+        TimePoint& cooldownEnd = m_lastPacket[m_packetCooldownSlots[opcode]];
+        auto now = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
+        if (now < cooldownEnd) // packet on cooldown
+        {
+            ReleasePacket(std::move(pct));
+            return true;
+        }
+        else // start cooldown and allow execution
+            cooldownEnd = now + std::chrono::milliseconds(WorldSocket::m_packetCooldowns[opcode]);
+    }
+
+    try
+    {
+        switch (opcode)
+        {
+            case CMSG_AUTH_SESSION:
+                if (m_session)
                 {
-                    case CMSG_AUTH_SESSION:
-                        if (self->m_session)
-                        {
-                            sLog.outError("WorldSocket::ProcessIncomingData: Player send CMSG_AUTH_SESSION again");
-                            return;
-                        }
-
-                        if (!self->HandleAuthSession(*pct))
-                            return;
-                        break;
-                    case CMSG_PING:
-                        if (!self->HandlePing(*pct))
-                            return;
-                        break;
-                    case CMSG_KEEP_ALIVE:
-                        DEBUG_LOG("CMSG_KEEP_ALIVE, size: " SIZEFMTD " ", pct->size());
-                        break;
-                    case CMSG_TIME_SYNC_RESP:
-                        pct->SetReceivedTime(std::chrono::steady_clock::now());
-                        [[fallthrough]];
-                    default:
-                    {
-                        self->m_opcodeHistoryInc.push_front(uint32(pct->GetOpcode()));
-                        if (self->m_opcodeHistoryInc.size() > 50)
-                            self->m_opcodeHistoryInc.resize(30);
-
-                        if (!self->m_session)
-                        {
-                            sLog.outError("WorldSocket::ProcessIncomingData: Client not authed opcode = %u", uint32(opcode));
-                            return;
-                        }
-
-                        self->m_session->QueuePacket(std::move(pct));
-                        break;
-                    }
+                    sLog.outError("WorldSocket::ProcessIncomingData: Player send CMSG_AUTH_SESSION again");
+                    return false;
                 }
-            }
-            catch (ByteBufferException&)
+
+                if (!HandleAuthSession(*pct))
+                    return false;
+                break;
+            case CMSG_PING:
+                if (!HandlePing(*pct))
+                    return false;
+                break;
+            case CMSG_KEEP_ALIVE:
+                DEBUG_LOG("CMSG_KEEP_ALIVE, size: " SIZEFMTD " ", pct->size());
+                break;
+            case CMSG_TIME_SYNC_RESP:
+                pct->SetReceivedTime(std::chrono::steady_clock::now());
+                [[fallthrough]];
+            default:
             {
-                sLog.outError("WorldSocket::ProcessIncomingData ByteBufferException occured while parsing an instant handled packet (opcode: %u) from client %s, accountid=%i.",
-                    opcode, self->GetRemoteAddress().c_str(), self->m_session ? self->m_session->GetAccountId() : -1);
+                m_opcodeHistoryInc.push_front(uint32(pct->GetOpcode()));
+                if (m_opcodeHistoryInc.size() > 50)
+                    m_opcodeHistoryInc.resize(30);
 
-                if (sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
+                if (!m_session)
                 {
-                    DEBUG_LOG("Dumping error-causing packet:");
-                    pct->hexlike();
+                    sLog.outError("WorldSocket::ProcessIncomingData: Client not authed opcode = %u", uint32(opcode));
+                    return false;
                 }
 
-                if (sWorld.getConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET))
-                {
-                    DETAIL_LOG("Disconnecting session [account id %i / address %s] for badly formatted packet.",
-                        self->m_session ? self->m_session->GetAccountId() : -1, self->GetRemoteAddress().c_str());
-                    return;
-                }
+                m_session->QueuePacket(std::move(pct));
+                break;
             }
-            self->ProcessIncomingData();
-        });
-    });
+        }
+    }
+    catch (ByteBufferException&)
+    {
+        sLog.outError("WorldSocket::ProcessIncomingData ByteBufferException occured while parsing an instant handled packet (opcode: %u) from client %s, accountid=%i.",
+            opcode, GetRemoteAddress().c_str(), m_session ? m_session->GetAccountId() : -1);
+
+        if (sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
+        {
+            DEBUG_LOG("Dumping error-causing packet:");
+            pct->hexlike();
+        }
+
+        if (sWorld.getConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET))
+        {
+            DETAIL_LOG("Disconnecting session [account id %i / address %s] for badly formatted packet.",
+                m_session ? m_session->GetAccountId() : -1, GetRemoteAddress().c_str());
+            return false;
+        }
+    }
+
+    // packets handled here are not queued to the session
+    if (pct)
+        ReleasePacket(std::move(pct));
 
     return true;
 }
@@ -516,6 +741,7 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     SqlStatement stmt = LoginDatabase.CreateStatement(updAccount, "INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES(?,?," _NOW_ ",?)");
     stmt.PExecute(id, address.c_str(), std::to_string(LOGIN_TYPE_MANGOSD).c_str());
 
+    // everything sent before this point is the unencrypted auth challenge, which the client answered already
     m_crypt.Init(&K);
 
     m_session = sWorld.FindSession(id);
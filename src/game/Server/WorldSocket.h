@@ -29,10 +29,14 @@
 #include "AuthCrypt.h"
 #include "Auth/BigNumber.h"
 #include "Network/AsyncSocket.hpp"
+#include "Util/MPSCQueue.h"
 
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <deque>
+#include <memory>
+#include <vector>
 
 class WorldPacket;
 class WorldSession;
@@ -61,10 +65,12 @@ class WorldSession;
  * The calls to Update () method are managed by WorldSocketMgr
  * and ReactorRunnable.
  *
- * For input ,the class uses one 1024 bytes buffer on stack
- * to which it does recv() calls. And then received data is
- * distributed where its needed. 1024 matches pretty well the
- * traffic generated by client for now.
+ * For input the class uses one receive buffer per socket to
+ * which it does recv() calls. Headers are decrypted in place and
+ * the body is copied into the packet once, the rest of a body
+ * that did not arrive yet is received straight into the packet.
+ * Packets are taken from per thread caches backed by a shared
+ * pool, sessions return them after handling.
  *
  * The input/output do speculative reads/writes (AKA it tries
  * to read all data available in the kernel buffer or tries to
@@ -109,9 +115,23 @@ class WorldSocket : public MaNGOS::AsyncSocket<WorldSocket>
 
         BigNumber m_s;
 
-        /// process one incoming packet.
+        /// Received data not yet framed, an incomplete header stays at the front of the buffer.
+        std::vector<uint8> m_readBuffer;
+        size_t m_readBufferSize;
+
+        /// Packet whose body did not fit into m_readBuffer, the rest of the body is received straight into it.
+        std::unique_ptr<WorldPacket> m_pendingPacket;
+        size_t m_pendingPacketReceived;
+
+        /// receive as much as available and process the complete packets.
         virtual bool ProcessIncomingData() override;
 
+        /// Frames and processes all complete packets in m_readBuffer, false if the socket must stop reading.
+        bool ProcessReceivedData();
+
+        /// process one incoming packet, false if the socket must stop reading.
+        bool ProcessPacket(std::unique_ptr<WorldPacket> pct);
+
         /// Called by ProcessIncoming() on CMSG_AUTH_SESSION.
         bool HandleAuthSession(WorldPacket& recvPacket);
 
@@ -120,6 +140,41 @@ class WorldSocket : public MaNGOS::AsyncSocket<WorldSocket>
 
         std::mutex m_worldSocketMutex;
 
+        struct OutgoingPacket
+        {
+            uint16 opcode;
+            uint8 header[5];                                // encrypted server header, set by FlushOutgoing
+            uint8 headerSize;
+            std::vector<uint8> payload;
+        };
+
+        /// Packets sent from any thread (mostly map threads), framed and encrypted by FlushOutgoing in the socket strand.
+        /// Only a few nodes are pooled per socket, bursts beyond that allocate.
+        MPSCQueue<OutgoingPacket, 4> m_outQueue;
+        std::atomic<bool> m_flushPending;
+
+        /// Outbound packets - queued payloads are swapped into m_outPackets with their header encrypted while m_sendPackets
+        /// is written straight from its buffers, everything gathered meanwhile goes out with the next write.
+        /// The first m_*PacketCount entries are in use, the others keep their buffer for reuse. Only used from the socket strand.
+        std::vector<OutgoingPacket> m_outPackets;
+        std::vector<OutgoingPacket> m_sendPackets;
+        size_t m_outPacketCount;
+        size_t m_sendPacketCount;
+        size_t m_outBytes;
+        std::vector<boost::asio::const_buffer> m_sendBuffers;
+        bool m_writeInProgress;
+
+        void FlushOutgoing();
+        void StartWrite();
+        void HandleWriteComplete(const boost::system::error_code& error);
+
+        static std::atomic<uint64> m_sendWriteCount;
+        static std::atomic<uint64> m_sendByteCount;
+        static std::atomic<uint64> m_sendMaxQueuedBytes;
+
+        static std::mutex m_packetPoolMutex;
+        static std::vector<std::unique_ptr<WorldPacket>> m_packetPool;
+
         std::deque<uint32> m_opcodeHistoryOut;
         std::deque<uint32> m_opcodeHistoryInc;
 
@@ -142,10 +197,18 @@ class WorldSocket : public MaNGOS::AsyncSocket<WorldSocket>
         std::deque<uint32> GetIncOpcodeHistory();
 
         static std::vector<uint32> m_packetCooldowns;
-        std::map<uint32, TimePoint> m_lastPacket;
+        static std::vector<uint8> m_packetCooldownSlots;    // opcode -> index in m_lastPacket, only valid for opcodes with cooldown
+        std::vector<TimePoint> m_lastPacket;                // cooldown end per opcode with cooldown
+
+        /// Received packets are drawn from a pool, sessions hand them back once handled
+        static std::unique_ptr<WorldPacket> AcquirePacket(uint16 opcode, size_t size);
+        static void ReleasePacket(std::unique_ptr<WorldPacket> packet);
 
         bool IsLoggingPackets() const { return m_loggingPackets; }
         void SetPacketLogging(bool state) { m_loggingPackets = state; }
+
+        /// Outbound totals of all sockets since the previous call, for metrics
+        static void ConsumeSendStatistics(uint64& writes, uint64& bytes, uint64& maxQueuedBytes);
 };
 
 #endif  /* _WORLDSOCKET_H */
@@ -26,6 +26,7 @@
 #include "Entities/ObjectGuid.h"
 #include "Entities/Unit.h"
 #include "Entities/Player.h"
+#include "Grids/GridNotifiers.h"
 #include "Server/SQLStorages.h"
 #include "Spells/SpellEffectDefines.h"
 
@@ -1165,6 +1166,7 @@ namespace MaNGOS
         float i_centerX;
         float i_centerY;
         float i_centerZ;
+        AreaBounds i_bounds;
 
         float GetCenterX() const { return i_centerX; }
         float GetCenterY() const { return i_centerY; }
@@ -1172,12 +1174,14 @@ namespace MaNGOS
         SpellNotifierCreatureAndPlayer(Spell& spell, UnitList& data, float radius, float cone, SpellNotifyPushType type,
                                        SpellTargets TargetType = SPELL_TARGETS_AOE_ATTACKABLE, WorldObject* originalCaster = nullptr)
             : i_data(data), i_spell(spell), i_push_type(type), i_radius(radius), i_cone(cone), i_TargetType(TargetType),
-              i_originalCaster(originalCaster), i_castingObject(i_spell.GetCastingObject())
+              i_originalCaster(originalCaster), i_castingObject(i_spell.GetCastingObject()),
+              i_centerX(0.f), i_centerY(0.f), i_centerZ(0.f)
         {
             if (!i_originalCaster)
                 i_originalCaster = i_spell.GetAffectiveCasterObject();
             i_playerControlled = i_originalCaster  ? i_originalCaster->IsControlledByPlayer() : false;
 
+            bool hasCenter = false;
             switch (i_push_type)
             {
                 case PUSH_CONE:
@@ -1187,15 +1191,22 @@ namespace MaNGOS
                         i_centerX = i_castingObject->GetPositionX();
                         i_centerY = i_castingObject->GetPositionY();
                         i_centerZ = i_castingObject->GetPositionZ();
+                        hasCenter = true;
                     }
                     break;
                 case PUSH_SRC_CENTER:
                     if (i_spell.m_targets.m_targetMask & TARGET_FLAG_SOURCE_LOCATION)
+                    {
                         i_spell.m_targets.getSource(i_centerX, i_centerY, i_centerZ);
+                        hasCenter = true;
+                    }
                     break;
                 case PUSH_DEST_CENTER:
                     if (i_spell.m_targets.m_targetMask & TARGET_FLAG_DEST_LOCATION)
+                    {
                         i_spell.m_targets.getDestination(i_centerX, i_centerY, i_centerZ);
+                        hasCenter = true;
+                    }
                     break;
                 case PUSH_TARGET_CENTER:
                     if (Unit* target = i_spell.m_targets.getUnitTarget())
@@ -1203,11 +1214,17 @@ namespace MaNGOS
                         i_centerX = target->GetPositionX();
                         i_centerY = target->GetPositionY();
                         i_centerZ = target->GetPositionZ();
+                        hasCenter = true;
                     }
                     break;
                 default:
                     sLog.outError("SpellNotifierCreatureAndPlayer: unsupported PUSH_* case %u.", i_push_type);
             }
+
+            // every push type measures from the center and allows at most the target's combat reach on top of the radius
+            // without a resolved center the old unbounded behaviour is kept
+            if (hasCenter)
+                i_bounds = AreaBounds(i_centerX, i_centerY, i_radius);
         }
 
         template<class T> inline void Visit(GridRefManager<T>& m)
@@ -1217,6 +1234,10 @@ namespace MaNGOS
 
             for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
             {
+                // most objects of the visited cells are out of range, skip them before the phase and faction checks
+                if (!i_bounds.IsInBounds(itr->getSource()))
+                    continue;
+
                 // there are still more spells which can be casted on dead, but
                 // they are no AOE and don't have such a nice SPELL_ATTR flag
                 // mostly phase check
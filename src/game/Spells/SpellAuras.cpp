@@ -675,14 +675,14 @@ void AreaAura::Update(uint32 diff)
                 case AREA_AURA_FRIEND:
                 {
                     MaNGOS::AnySpellAssistableUnitInObjectRangeCheck u_check(caster, nullptr, m_radius, GetSpellProto()->HasAttribute(SPELL_ATTR_EX6_IGNORE_PHASE_SHIFT));
-                    MaNGOS::UnitListSearcher<MaNGOS::AnySpellAssistableUnitInObjectRangeCheck> searcher(targets, u_check);
+                    MaNGOS::UnitListSearcher<MaNGOS::AnySpellAssistableUnitInObjectRangeCheck> searcher(targets, u_check, MaNGOS::AreaBounds(caster, m_radius));
                     Cell::VisitAllObjects(caster, searcher, m_radius);
                     break;
                 }
                 case AREA_AURA_ENEMY:
                 {
                     MaNGOS::AnyAoETargetUnitInObjectRangeCheck u_check(caster, nullptr, m_radius, GetSpellProto()->HasAttribute(SPELL_ATTR_EX6_IGNORE_PHASE_SHIFT)); // No GetCharmer in searcher
-                    MaNGOS::UnitListSearcher<MaNGOS::AnyAoETargetUnitInObjectRangeCheck> searcher(targets, u_check);
+                    MaNGOS::UnitListSearcher<MaNGOS::AnyAoETargetUnitInObjectRangeCheck> searcher(targets, u_check, MaNGOS::AreaBounds(caster, m_radius));
                     Cell::VisitAllObjects(caster, searcher, m_radius);
                     break;
                 }
@@ -931,6 +931,9 @@ void Aura::ApplyModifier(bool apply, bool Real)
 
     if (GetSpellProto()->HasAttribute(SPELL_ATTR_EX4_OWNER_POWER_SCALING) && m_removeMode != AURA_REMOVE_BY_GAINED_STACK)
         GetTarget()->RegisterScalingAura(this, apply);
+
+    // handlers can make the aura periodic
+    GetHolder()->ResumeUpdate();
 }
 
 void Aura::UpdateAuraScaling()
@@ -9741,7 +9744,7 @@ SpellAuraHolder::SpellAuraHolder(SpellEntry const* spellproto, Unit* target, Wor
     m_stackAmount(1), m_timeCla(1000), m_removeMode(AURA_REMOVE_BY_DEFAULT),
     m_AuraDRGroup(DIMINISHING_NONE), m_permanent(false), m_isRemovedOnShapeLost(true),
     m_heartbeatResistChance(0), m_heartbeatResistTimer(0), m_heartbeatResistInterval(0),
-    m_deleted(false), m_skipUpdate(false), m_reducedProcChancePast60(false),
+    m_deleted(false), m_skipUpdate(false), m_updateSuspended(false), m_reducedProcChancePast60(false),
     m_auraScript(SpellScriptMgr::GetAuraScript(spellproto->Id))
 {
     MANGOS_ASSERT(target);
@@ -10958,6 +10961,30 @@ void SpellAuraHolder::Update(uint32 diff)
     }
 }
 
+bool SpellAuraHolder::IsUpdateIdle() const
+{
+    if (m_duration > 0)
+        return false;
+
+    for (auto aura : m_auras)
+        if (aura && !aura->IsUpdateIdle())
+            return false;
+
+    return true;
+}
+
+void SpellAuraHolder::ResumeUpdate()
+{
+    if (m_updateSuspended && !IsDeleted())
+        m_target->ResumeSpellAuraHolderUpdate(this);
+}
+
+void SpellAuraHolder::SetAuraDuration(int32 duration)
+{
+    m_duration = duration;
+    ResumeUpdate();
+}
+
 void SpellAuraHolder::RefreshHolder()
 {
     SetAuraDuration(GetAuraMaxDuration());
@@ -11413,6 +11440,7 @@ void Aura::ForcePeriodicity(uint32 periodicTime)
         m_isPeriodic = true;
     m_modifier.periodictime = periodicTime;
     m_periodicTimer = periodicTime;
+    GetHolder()->ResumeUpdate();
 }
 
 void Aura::OnPeriodicTrigger(PeriodicTriggerData& data)
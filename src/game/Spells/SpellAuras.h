@@ -129,7 +129,7 @@ class SpellAuraHolder
         void SetTarget(Unit* target) { m_target = target; }
 
         bool IsPermanent() const { return m_permanent; }
-        void SetPermanent(bool permanent) { m_permanent = permanent; }
+        void SetPermanent(bool permanent) { m_permanent = permanent; ResumeUpdate(); }
         bool IsPassive() const { return m_isPassive; }
         bool IsDeathPersistent() const { return m_isDeathPersist; }
         bool IsPersistent() const;
@@ -149,6 +149,12 @@ class SpellAuraHolder
         void Update(uint32 diff);
         void RefreshHolder();
 
+        // no running duration and no aura with work in Update - the holder can leave the owner's update list
+        bool IsUpdateIdle() const;
+        bool IsUpdateSuspended() const { return m_updateSuspended; }
+        void SetUpdateSuspended(bool suspended) { m_updateSuspended = suspended; }
+        void ResumeUpdate();
+
         TrackedAuraType GetTrackedAuraType() const { return m_trackedAuraType; }
         void SetTrackedAuraType(TrackedAuraType val) { m_trackedAuraType = val; }
         void UnregisterAndCleanupTrackedAuras(uint32 auraFlags);
@@ -156,7 +162,7 @@ class SpellAuraHolder
         int32 GetAuraMaxDuration() const { return m_maxDuration; }
         void SetAuraMaxDuration(int32 duration);
         int32 GetAuraDuration() const { return m_duration; }
-        void SetAuraDuration(int32 duration) { m_duration = duration; }
+        void SetAuraDuration(int32 duration);
 
         void SetHeartbeatResist(uint32 chance, int32 originalDuration, uint32 drLevel);
 
@@ -251,6 +257,7 @@ class SpellAuraHolder
         bool m_isRemovedOnShapeLost: 1;
         bool m_deleted: 1;
         bool m_skipUpdate: 1;
+        bool m_updateSuspended: 1;                          // idle, not in the owner's update list
 
         TimePoint m_procCooldown;
 
@@ -509,6 +516,7 @@ class Aura
         void UpdateAuraScaling();
 
         void UpdateAura(uint32 diff) { Update(diff); }
+        virtual bool IsUpdateIdle() const { return !m_isPeriodic; }
 
         void SetRemoveMode(AuraRemoveMode mode) { m_removeMode = mode; }
         AuraRemoveMode GetRemoveMode() { return m_removeMode; }
@@ -621,6 +629,7 @@ class AreaAura : public Aura
         virtual ~AreaAura();
 
         bool OnAreaAuraCheckTarget(Unit* target) const;
+        bool IsUpdateIdle() const override { return false; }
     protected:
         void Update(uint32 diff) override;
     private:
@@ -634,6 +643,7 @@ class PersistentAreaAura : public Aura
     public:
         PersistentAreaAura(SpellEntry const* spellproto, SpellEffectIndex eff, int32 const* currentDamage, int32 const* currentBasePoints, SpellAuraHolder* holder, Unit* target, Unit* caster = nullptr, Item* castItem = nullptr);
         virtual ~PersistentAreaAura();
+        bool IsUpdateIdle() const override { return false; }
     protected:
         void Update(uint32 diff) override;
 };
@@ -644,6 +654,7 @@ class GameObjectAura : public Aura
     public:
         GameObjectAura(SpellEntry const* spellproto, SpellEffectIndex eff, int32 const* currentDamage, int32 const* currentBasePoints, SpellAuraHolder* holder, Unit* target, GameObject* caster);
         virtual ~GameObjectAura();
+        bool IsUpdateIdle() const override { return false; }
 
     protected:
         void Update(uint32 diff) override;
@@ -2991,6 +2991,15 @@ class SpellMgr
             return nullptr;
         }
 
+        // Proc flags an aura of the spell responds to, spell_proc_event flags override the dbc ones
+        uint32 GetSpellProcFlags(SpellEntry const* spellInfo) const
+        {
+            SpellProcEventEntry const* spellProcEvent = GetSpellProcEvent(spellInfo->Id);
+            if (spellProcEvent && spellProcEvent->procFlags)
+                return spellProcEvent->procFlags;
+            return spellInfo->procFlags;
+        }
+
         // Spell procs from item enchants
         float GetItemEnchantProcChance(uint32 spellid) const
         {
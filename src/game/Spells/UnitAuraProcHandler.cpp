@@ -28,6 +28,10 @@
 #include "Entities/Creature.h"
 #include "Util/Util.h"
 
+#ifdef BUILD_METRICS
+ #include "Metric/Metric.h"
+#endif
+
 pAuraProcHandler AuraProcHandler[TOTAL_AURAS] =
 {
     &Unit::HandleNULLProc,                                  //  0 SPELL_AURA_NONE
@@ -538,14 +542,27 @@ void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
 
     ProcTriggeredList procTriggered;
     std::vector<SpellAuraHolder*> holdersForDeletion;
+#ifdef BUILD_METRICS
+    static metric::counter procChecks("unit.proc.checks");
+    static metric::counter procSkipped("unit.proc.skipped");
+    uint32 checked = 0;
+#endif
     // Fill procTriggered list
-    for (SpellAuraHolderMap::const_iterator itr = GetSpellAuraHolderMap().begin(); itr != GetSpellAuraHolderMap().end(); ++itr)
+    // only holders with proc flags matching the event are checked, the others can't trigger (see SpellMgr::IsSpellProcEventCanTriggeredBy)
+    for (ProcAuraHolderMap::const_iterator itr = m_procAuraHolders.begin(); itr != m_procAuraHolders.end(); ++itr)
     {
-        SpellAuraHolder* holder = itr->second;
+        if (!(itr->second.first & execData.procFlags))
+            continue;
+
+        SpellAuraHolder* holder = itr->second.second;
         // skip deleted auras (possible at recursive triggered call
         if (holder->GetState() != SPELLAURAHOLDER_STATE_READY || holder->IsDeleted())
             continue;
 
+#ifdef BUILD_METRICS
+        ++checked;
+#endif
+
         SpellProcEventEntry const* spellProcEvent = nullptr;
         SpellProcEventTriggerCheck result = IsTriggeredAtSpellProcEvent(execData, holder, spellProcEvent);
         if (holder->GetSpellProto()->HasAttribute(SPELL_ATTR_PROC_FAILURE_BURNS_CHARGE) &&
@@ -564,9 +581,14 @@ void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
         if (result != SpellProcEventTriggerCheck::SPELL_PROC_TRIGGER_OK)
             continue;
 
-        procTriggered.push_back(ProcTriggeredData(spellProcEvent, itr->second));
+        procTriggered.push_back(ProcTriggeredData(spellProcEvent, holder));
     }
 
+#ifdef BUILD_METRICS
+    procChecks.add(checked);
+    procSkipped.add(int64(m_spellAuraHolders.size()) - checked);
+#endif
+
     for (SpellAuraHolder* holder : holdersForDeletion)
         if (holder->DropAuraCharge())
             RemoveSpellAuraHolder(holder);
@@ -30,6 +30,7 @@
 #include "Server/Opcodes.h"
 #include "Server/WorldSession.h"
 #include "Server/WorldPacket.h"
+#include "Server/WorldSocket.h"
 #include "Entities/Player.h"
 #include "Skills/SkillExtraItems.h"
 #include "Skills/SkillDiscovery.h"
@@ -57,6 +58,7 @@
 #include "GameEvents/GameEventMgr.h"
 #include "Pools/PoolManager.h"
 #include "Database/DatabaseImpl.h"
+#include "Database/SQLStorageSnapshot.h"
 #include "Grids/GridNotifiersImpl.h"
 #include "Grids/CellImpl.h"
 #include "Maps/MapPersistentStateMgr.h"
@@ -68,6 +70,7 @@
 #include "Calendar/Calendar.h"
 #include "Weather/Weather.h"
 #include "World/WorldState.h"
+#include "World/WorldLoader.h"
 #include "Cinematics/CinematicMgr.h"
 #include "Maps/TransportMgr.h"
 #include "Anticheat/Anticheat.hpp"
@@ -498,6 +501,9 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
+    setConfig(CONFIG_BOOL_MAP_FILES_MEMORY_MAPPED, "MapFiles.MemoryMapped", false);
+    setConfig(CONFIG_BOOL_GRID_PRELOAD, "GridPreload.Enable", false);
+    setConfigMin(CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD, "GridPreload.Lookahead", 10 * IN_MILLISECONDS, IN_MILLISECONDS);
     setConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS, "MaxWhoListReturns", 49);
 
     std::string forceLoadGridOnMaps = sConfig.GetStringDefault("LoadAllGridsOnMaps");
@@ -646,6 +652,11 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_NUM_MAP_THREADS, "MapUpdate.Threads", 3);
+    setConfig(CONFIG_BOOL_MAP_PARALLEL_UPDATE, "MapUpdate.Parallel.Enable", false);
+    setConfigMin(CONFIG_UINT32_MAP_PARALLEL_UPDATE_MIN_OBJECTS, "MapUpdate.Parallel.MinObjects", 1000, 1);
+    setConfig(CONFIG_BOOL_MAP_PARALLEL_SEND, "MapUpdate.ParallelSend.Enable", false);
+    setConfigMin(CONFIG_UINT32_MAP_PARALLEL_SEND_MIN_OBJECTS, "MapUpdate.ParallelSend.MinObjects", 200, 1);
+    setConfig(CONFIG_UINT32_NUM_LOADER_THREADS, "StartupLoader.Threads", 0);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_ORANGE, "SkillChance.Orange", 100);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_YELLOW, "SkillChance.Yellow", 75);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_GREEN,  "SkillChance.Green",  25);
@@ -734,6 +745,8 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_FLOAT_LEASH_RADIUS, "LeashRadius", 30.f);
     setConfigMin(CONFIG_UINT32_CREATURE_RESPAWN_AGGRO_DELAY, "CreatureRespawnAggroDelay", 5000, 0);
     setConfig(CONFIG_UINT32_CREATURE_PICKPOCKET_RESTOCK_DELAY, "CreaturePickpocketRestockDelay", 600);
+    setConfig(CONFIG_UINT32_CREATURE_IDLE_UPDATE_INTERVAL, "CreatureIdleUpdateInterval", 0);
+    setConfigPos(CONFIG_FLOAT_CREATURE_IDLE_UPDATE_DISTANCE, "CreatureIdleUpdateDistance", 40.0f);
 
     // always use declined names in the russian client
     if (getConfig(CONFIG_UINT32_REALM_ZONE) == REALM_ZONE_RUSSIAN)
@@ -751,6 +764,7 @@ void World::LoadConfigSettings(bool reload)
     setConfigMinMax(CONFIG_UINT32_BATTLEGROUND_RANDOM_RESET_HOUR,      "BattleGround.Random.ResetHour", 6, 0, 23);
     setConfig(CONFIG_UINT32_ARENA_MAX_RATING_DIFFERENCE,               "Arena.MaxRatingDifference", 150);
     setConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER,                "Arena.RatingDiscardTimer", 10 * MINUTE * IN_MILLISECONDS);
+    setConfig(CONFIG_UINT32_ARENA_RATING_WINDOW_GROWTH,                "Arena.RatingWindowGrowth", 0);
     setConfig(CONFIG_BOOL_ARENA_AUTO_DISTRIBUTE_POINTS,                "Arena.AutoDistributePoints", false);
     setConfig(CONFIG_UINT32_ARENA_AUTO_DISTRIBUTE_INTERVAL_DAYS,       "Arena.AutoDistributeInterval", 7);
     setConfig(CONFIG_BOOL_ARENA_QUEUE_ANNOUNCER_JOIN,                  "Arena.QueueAnnouncer.Join", false);
@@ -884,6 +898,13 @@ void World::LoadConfigSettings(bool reload)
     {
         m_dataPath = dataPath;
         sLog.outString("Using DataDir %s", m_dataPath.c_str());
+
+        std::string snapshotDir = sConfig.GetStringDefault("WorldDatabaseSnapshotDir");
+        if (!snapshotDir.empty())
+        {
+            SQLStorageSnapshot::SetDirectory(snapshotDir);
+            sLog.outString("Using world database snapshots in %s", snapshotDir.c_str());
+        }
     }
 
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
@@ -1278,96 +1299,153 @@ void World::SetInitialWorldSettings()
     sLog.outString("Loading Player level dependent mail rewards...");
     sObjectMgr.LoadMailLevelRewards();
 
-    sLog.outString("Loading Loot Tables...");
+    ///- Independent static data loaders run side by side, every loader lists the loaders whose data it needs
+    WorldLoader loader;
     LootIdSet ids_set;
-    LoadLootTables(ids_set);
-    sLog.outString(">>> Loot Tables loaded");
-    sLog.outString();
 
-    sLog.outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
+    loader.Add("Loot Tables", [&ids_set]()
+    {
+        sLog.outString("Loading Loot Tables...");
+        LoadLootTables(ids_set);
+        sLog.outString(">>> Loot Tables loaded");
+        sLog.outString();
+    });
 
-    sLog.outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
+    loader.Add("Skill Discovery Table", []()
+    {
+        sLog.outString("Loading Skill Discovery Table...");
+        LoadSkillDiscoveryTable();
+    });
 
-    sLog.outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr.LoadFishingBaseSkillLevel();
+    loader.Add("Skill Extra Item Table", []()
+    {
+        sLog.outString("Loading Skill Extra Item Table...");
+        LoadSkillExtraItemTable();
+    });
 
-    sLog.outString("Loading Achievements...");
-    sAchievementMgr.LoadAchievementReferenceList();
-    sAchievementMgr.LoadAchievementCriteriaList();
-    sAchievementMgr.LoadAchievementCriteriaRequirements();
-    sAchievementMgr.LoadRewards();
-    sAchievementMgr.LoadRewardLocales();
-    sAchievementMgr.LoadCompletedAchievements();
-    sLog.outString(">>> Achievements loaded");
-    sLog.outString();
+    loader.Add("Skill Fishing base level", []()
+    {
+        sLog.outString("Loading Skill Fishing base level requirements...");
+        sObjectMgr.LoadFishingBaseSkillLevel();
+    });
 
-    sLog.outString("Loading access requirements...");
-    sObjectMgr.LoadAccessRequirements();                    // must be after achievements
-
-    sLog.outString("Loading Instance encounters data...");  // must be after Creature loading
-    sObjectMgr.LoadInstanceEncounters();
-
-    sLog.outString("Loading Npc Text Id...");
-    sObjectMgr.LoadNpcGossips();                            // must be after load Creature and LoadGossipText
-
-    sLog.outString("Loading Scripts random templates...");  // must be before String calls
-    sScriptMgr.LoadDbScriptRandomTemplates();
-    ///- Load and initialize DBScripts Engine
-    sLog.outString("Loading DB-Scripts Engine...");
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_RELAY);                // must be first in dbscripts loading
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GOSSIP);               // must be before gossip menu options
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_QUEST_START);          // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_QUEST_END);            // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_SPELL);                // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GAMEOBJECT);           // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GAMEOBJECT_TEMPLATE);  // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_EVENT);                // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_CREATURE_DEATH);       // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_CREATURE_MOVEMENT);    // before loading from creature_movement 
-    sLog.outString(">>> Scripts loaded");
-    sLog.outString();
+    loader.Add("Achievements", []()
+    {
+        sLog.outString("Loading Achievements...");
+        sAchievementMgr.LoadAchievementReferenceList();
+        sAchievementMgr.LoadAchievementCriteriaList();
+        sAchievementMgr.LoadAchievementCriteriaRequirements();
+        sAchievementMgr.LoadRewards();
+        sAchievementMgr.LoadRewardLocales();                // only loader of the graph adding storage locale indexes
+        sAchievementMgr.LoadCompletedAchievements();
+        sLog.outString(">>> Achievements loaded");
+        sLog.outString();
+    });
+
+    loader.Add("Access requirements", []()
+    {
+        sLog.outString("Loading access requirements...");
+        sObjectMgr.LoadAccessRequirements();
+    }, { "Achievements" });
+
+    loader.Add("Instance encounters", []()
+    {
+        sLog.outString("Loading Instance encounters data...");  // must be after Creature loading
+        sObjectMgr.LoadInstanceEncounters();
+    });
+
+    loader.Add("Npc Text Id", []()
+    {
+        sLog.outString("Loading Npc Text Id...");
+        sObjectMgr.LoadNpcGossips();                        // must be after load Creature and LoadGossipText
+    });
 
-    sLog.outString("Loading Scripts text locales...");      // must be after Load*Scripts calls
-    sScriptMgr.LoadDbScriptStrings();
+    loader.Add("DB-Scripts", []()
+    {
+        sLog.outString("Loading Scripts random templates...");  // must be before String calls
+        sScriptMgr.LoadDbScriptRandomTemplates();
+        ///- Load and initialize DBScripts Engine
+        sLog.outString("Loading DB-Scripts Engine...");
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_RELAY);                // must be first in dbscripts loading
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GOSSIP);               // must be before gossip menu options
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_QUEST_START);          // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_QUEST_END);            // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_SPELL);                // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GAMEOBJECT);           // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GAMEOBJECT_TEMPLATE);  // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_EVENT);                // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_CREATURE_DEATH);       // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_CREATURE_MOVEMENT);    // before loading from creature_movement
+        sLog.outString(">>> Scripts loaded");
+        sLog.outString();
 
-    sLog.outString("Loading Gossip Menus...");
-    sObjectMgr.LoadGossipMenus();
+        sLog.outString("Loading Scripts text locales...");  // must be after Load*Scripts calls
+        sScriptMgr.LoadDbScriptStrings();
+    });
 
-    sLog.outString("Loading Vendors...");
-    sObjectMgr.LoadVendorTemplates();                       // must be after load ItemTemplate
-    sObjectMgr.LoadVendors();                               // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
+    loader.Add("Gossip Menus", []()
+    {
+        sLog.outString("Loading Gossip Menus...");
+        sObjectMgr.LoadGossipMenus();
+    }, { "DB-Scripts" });
 
-    sLog.outString("Loading Trainers...");
-    sObjectMgr.LoadTrainerTemplates();                      // must be after load CreatureTemplate
-    sObjectMgr.LoadTrainers();                              // must be after load CreatureTemplate, TrainerTemplate
+    loader.Add("Vendors", []()
+    {
+        sLog.outString("Loading Vendors...");
+        sObjectMgr.LoadVendorTemplates();                   // must be after load ItemTemplate
+        sObjectMgr.LoadVendors();                           // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
+    });
 
-    sLog.outString("Loading Waypoint scripts...");
+    loader.Add("Trainers", []()
+    {
+        sLog.outString("Loading Trainers...");
+        sObjectMgr.LoadTrainerTemplates();                  // must be after load CreatureTemplate
+        sObjectMgr.LoadTrainers();                          // must be after load CreatureTemplate, TrainerTemplate
+    });
 
-    sLog.outString("Loading Waypoints...");
-    sWaypointMgr.Load();
+    loader.Add("Waypoints", []()
+    {
+        sLog.outString("Loading Waypoints...");
+        sWaypointMgr.Load();
+    }, { "DB-Scripts" });
 
-    sLog.outString("Loading ReservedNames...");
-    sObjectMgr.LoadReservedPlayersNames();
+    loader.Add("ReservedNames", []()
+    {
+        sLog.outString("Loading ReservedNames...");
+        sObjectMgr.LoadReservedPlayersNames();
+    });
 
-    sLog.outString("Loading GameObjects for quests...");
-    sObjectMgr.LoadGameObjectForQuests();
+    loader.Add("GameObjects for quests", []()
+    {
+        sLog.outString("Loading GameObjects for quests...");
+        sObjectMgr.LoadGameObjectForQuests();
+    }, { "Loot Tables" });                                  // scans chest loot for quest items
 
-    sLog.outString("Loading BattleMasters...");
-    sBattleGroundMgr.LoadBattleMastersEntry();
+    loader.Add("BattleMasters", []()
+    {
+        sLog.outString("Loading BattleMasters...");
+        sBattleGroundMgr.LoadBattleMastersEntry();
 
-    sLog.outString("Loading BattleGround event indexes...");
-    sBattleGroundMgr.LoadBattleEventIndexes();
+        sLog.outString("Loading BattleGround event indexes...");
+        sBattleGroundMgr.LoadBattleEventIndexes();
+    });
+
+    loader.Add("GameTeleports", []()
+    {
+        sLog.outString("Loading GameTeleports...");
+        sObjectMgr.LoadGameTele();
+    });
 
-    sLog.outString("Loading GameTeleports...");
-    sObjectMgr.LoadGameTele();
+    loader.Add("Greetings", []()
+    {
+        sLog.outString("Loading Questgiver Greetings...");
+        sObjectMgr.LoadQuestgiverGreeting();
 
-    sLog.outString("Loading Questgiver Greetings...");
-    sObjectMgr.LoadQuestgiverGreeting();
+        sLog.outString("Loading Trainer Greetings...");
+        sObjectMgr.LoadTrainerGreetings();
+    });
 
-    sLog.outString("Loading Trainer Greetings...");
-    sObjectMgr.LoadTrainerGreetings();
+    loader.Run(getConfig(CONFIG_UINT32_NUM_LOADER_THREADS));
 
     ///- Loading localization data
     sLog.outString("Loading Localization strings...");
@@ -1548,6 +1626,8 @@ void World::SetInitialWorldSettings()
     sLog.outString("---------------------------------------");
     sLog.outString();
 
+    loader.LogTimings();
+
     uint32 uStartInterval = WorldTimer::getMSTimeDiff(uStartTime, WorldTimer::getMSTime());
     sLog.outString("SERVER STARTUP TIME: %i minutes %i seconds", uStartInterval / 60000, (uStartInterval % 60000) / 1000);
     sLog.outString();
@@ -2869,6 +2949,27 @@ void World::GeneratePacketMetrics()
 
     metric::measurement meas_latency("world.metrics.latency");
     meas_latency.add_field("online", std::to_string(GetAverageLatency()));
+
+    uint64 writes, bytes, maxQueuedBytes;
+    WorldSocket::ConsumeSendStatistics(writes, bytes, maxQueuedBytes);
+    metric::measurement meas_send("world.metrics.network.send");
+    meas_send.add_field("writes", std::to_string(writes));
+    meas_send.add_field("bytes", std::to_string(bytes));
+    meas_send.add_field("bytes_per_write", std::to_string(writes ? bytes / writes : 0));
+    meas_send.add_field("max_queued_bytes", std::to_string(maxQueuedBytes));
+
+    std::pair<char const*, Database*> databases[] = { {"world", &WorldDatabase}, {"characters", &CharacterDatabase}, {"login", &LoginDatabase}, {"logs", &LogsDatabase} };
+    for (auto& database : databases)
+    {
+        uint64 queued, executed, waitTimeTotal, waitTimeMax;
+        database.second->ConsumeDelayStatistics(queued, executed, waitTimeTotal, waitTimeMax);
+
+        metric::measurement meas_db("world.metrics.database.async", { {"database", database.first} });
+        meas_db.add_field("queued", std::to_string(queued));
+        meas_db.add_field("executed", std::to_string(executed));
+        meas_db.add_field("avg_wait_us", std::to_string(executed ? waitTimeTotal / executed : 0));
+        meas_db.add_field("max_wait_us", std::to_string(waitTimeMax));
+    }
 }
 
 uint32 World::GetAverageLatency() const
@@ -151,6 +151,10 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_NUM_MAP_THREADS,
+    CONFIG_UINT32_MAP_PARALLEL_UPDATE_MIN_OBJECTS,
+    CONFIG_UINT32_MAP_PARALLEL_SEND_MIN_OBJECTS,
+    CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD,
+    CONFIG_UINT32_NUM_LOADER_THREADS,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
     CONFIG_UINT32_SKILL_CHANCE_ORANGE,
     CONFIG_UINT32_SKILL_CHANCE_YELLOW,
@@ -189,6 +193,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_BATTLEGROUND_RANDOM_RESET_HOUR,
     CONFIG_UINT32_ARENA_MAX_RATING_DIFFERENCE,
     CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER,
+    CONFIG_UINT32_ARENA_RATING_WINDOW_GROWTH,
     CONFIG_UINT32_ARENA_AUTO_DISTRIBUTE_INTERVAL_DAYS,
     CONFIG_UINT32_ARENA_SEASON_ID,
     CONFIG_UINT32_ARENA_FIRST_RESET_DAY,
@@ -221,6 +226,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_FOGOFWAR_HEALTH,
     CONFIG_UINT32_FOGOFWAR_STATS,
     CONFIG_UINT32_CREATURE_PICKPOCKET_RESTOCK_DELAY,
+    CONFIG_UINT32_CREATURE_IDLE_UPDATE_INTERVAL,
     CONFIG_UINT32_CHANNEL_STATIC_AUTO_TRESHOLD,
     CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL,
     CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL_DIFFERENCE,
@@ -321,6 +327,7 @@ enum eConfigFloatValues
     CONFIG_FLOAT_CREATURE_FAMILY_FLEE_ASSISTANCE_RADIUS,
     CONFIG_FLOAT_CREATURE_FAMILY_ASSISTANCE_RADIUS,
     CONFIG_FLOAT_CREATURE_CHECK_FOR_HELP_RADIUS,
+    CONFIG_FLOAT_CREATURE_IDLE_UPDATE_DISTANCE,
     CONFIG_FLOAT_GROUP_XP_DISTANCE,
     CONFIG_FLOAT_GHOST_RUN_SPEED_WORLD,
     CONFIG_FLOAT_GHOST_RUN_SPEED_BG,
@@ -415,6 +422,10 @@ enum eConfigBoolValues
     CONFIG_BOOL_PATH_FIND_NORMALIZE_Z,
     CONFIG_BOOL_ALWAYS_SHOW_QUEST_GREETING,
     CONFIG_BOOL_DISABLE_INSTANCE_RELOCATE,
+    CONFIG_BOOL_MAP_PARALLEL_UPDATE,
+    CONFIG_BOOL_MAP_PARALLEL_SEND,
+    CONFIG_BOOL_MAP_FILES_MEMORY_MAPPED,
+    CONFIG_BOOL_GRID_PRELOAD,
     CONFIG_BOOL_VALUE_COUNT
 };
 
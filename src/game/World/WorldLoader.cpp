@@ -0,0 +1,129 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/WorldLoader.h"
+#include "Database/DatabaseEnv.h"
+#include "Log/Log.h"
+#include "Util/ProgressBar.h"
+#include "Util/Timer.h"
+
+#include <thread>
+#include <algorithm>
+
+void WorldLoader::Add(char const* name, LoadFunction function, std::initializer_list<char const*> dependencies)
+{
+    size_t index = m_loaders.size();
+    m_loaders.push_back({ name, std::move(function), {}, uint32(dependencies.size()), 0 });
+
+    for (char const* dependency : dependencies)
+    {
+        auto itr = std::find_if(m_loaders.begin(), m_loaders.begin() + index, [dependency](Loader const& loader) { return loader.name == dependency; });
+        MANGOS_ASSERT(itr != m_loaders.begin() + index && "WorldLoader dependency must be added before its dependents");
+        itr->dependents.push_back(index);
+    }
+}
+
+void WorldLoader::Run(uint32 numThreads)
+{
+    uint32 startTime = WorldTimer::getMSTime();
+
+    if (!numThreads)
+    {
+        // adding order is a valid execution order
+        for (Loader& loader : m_loaders)
+            Execute(loader);
+
+        m_runTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+        return;
+    }
+
+    m_pending = m_loaders.size();
+    for (size_t i = 0; i < m_loaders.size(); ++i)
+        if (!m_loaders[i].pendingDependencies)
+            m_ready.push_back(i);
+
+    // progress bars of loaders running side by side would garble the console
+    bool showOutput = BarGoLink::GetOutputState();
+    BarGoLink::SetOutputState(false);
+
+    std::vector<std::thread> threads;
+    for (uint32 i = 0; i < numThreads; ++i)
+        threads.emplace_back(&WorldLoader::WorkerThread, this);
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    BarGoLink::SetOutputState(showOutput);
+
+    m_runTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+}
+
+void WorldLoader::WorkerThread()
+{
+    WorldDatabase.ThreadStart();                            // let thread do safe mySQL requests (one connection call enough)
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (true)
+    {
+        m_condition.wait(lock, [this] { return !m_ready.empty() || !m_pending; });
+        if (m_ready.empty())
+            break;
+
+        size_t index = m_ready.front();
+        m_ready.pop_front();
+
+        lock.unlock();
+        Execute(m_loaders[index]);
+        lock.lock();
+
+        for (size_t dependent : m_loaders[index].dependents)
+            if (!--m_loaders[dependent].pendingDependencies)
+                m_ready.push_back(dependent);
+
+        --m_pending;
+        m_condition.notify_all();
+    }
+
+    lock.unlock();
+    WorldDatabase.ThreadEnd();                              // free mySQL thread resources
+}
+
+void WorldLoader::Execute(Loader& loader)
+{
+    uint32 startTime = WorldTimer::getMSTime();
+    loader.function();
+    loader.loadTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+}
+
+void WorldLoader::LogTimings() const
+{
+    std::vector<Loader const*> loaders;
+    uint32 totalTime = 0;
+    for (Loader const& loader : m_loaders)
+    {
+        loaders.push_back(&loader);
+        totalTime += loader.loadTime;
+    }
+
+    std::sort(loaders.begin(), loaders.end(), [](Loader const* a, Loader const* b) { return a->loadTime > b->loadTime; });
+
+    sLog.outString("Startup loader timings (%u ms spent in loaders, %u ms elapsed):", totalTime, m_runTime);
+    for (Loader const* loader : loaders)
+        sLog.outString("  %6u ms  %s", loader->loadTime, loader->name.c_str());
+    sLog.outString();
+}
@@ -0,0 +1,74 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_WORLDLOADER_H
+#define MANGOS_WORLDLOADER_H
+
+#include "Platform/Define.h"
+
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <string>
+#include <functional>
+#include <condition_variable>
+#include <initializer_list>
+
+// runs the startup loaders of World::SetInitialWorldSettings as a dependency graph
+// a loader starts as soon as all loaders it depends on finished, independent loaders run side by side
+// loaders must declare every loader whose data they read or whose containers they share
+class WorldLoader
+{
+    public:
+        typedef std::function<void()> LoadFunction;
+
+        WorldLoader() : m_runTime(0), m_pending(0) {}
+        WorldLoader(const WorldLoader&) = delete;
+
+        // dependencies must have been added before, so the graph can't contain cycles
+        void Add(char const* name, LoadFunction function, std::initializer_list<char const*> dependencies = {});
+
+        // returns once all loaders finished, with 0 threads the loaders run in the order they were added
+        void Run(uint32 numThreads);
+
+        // logs the time spent in every loader, slowest first
+        void LogTimings() const;
+
+    private:
+        struct Loader
+        {
+            std::string name;
+            LoadFunction function;
+            std::vector<size_t> dependents;                 // loaders waiting for this one
+            uint32 pendingDependencies;
+            uint32 loadTime;
+        };
+
+        void WorkerThread();
+        void Execute(Loader& loader);
+
+        std::vector<Loader> m_loaders;
+        uint32 m_runTime;
+
+        std::mutex m_lock;
+        std::condition_variable m_condition;
+        std::deque<size_t> m_ready;                         // loaders with all dependencies done
+        size_t m_pending;                                   // loaders not finished yet
+};
+
+#endif
@@ -135,6 +135,9 @@ int Master::Run()
     LoginDatabase.AllowAsyncTransactions();
     LogsDatabase.AllowAsyncTransactions();
 
+    // startup output is written directly, it mixes with progress bars and has no concurrency to speak of
+    sLog.StartAsync();
+
     ///- Catch termination signals
     _HookSignals();
 
@@ -325,6 +328,8 @@ int Master::Run()
         delete cliThread;
     }
 
+    sLog.StopAsync();
+
     // mark this can be killable
     m_canBeKilled = true;
 
@@ -338,15 +343,16 @@ bool Master::_StartDB()
     ///- Get world database info from configuration file
     std::string dbstring = sConfig.GetStringDefault("WorldDatabaseInfo");
     int nConnections = sConfig.GetIntDefault("WorldDatabaseConnections", 1);
+    int nAsyncConnections = sConfig.GetIntDefault("WorldDatabaseAsyncConnections", 1);
     if (dbstring.empty())
     {
         sLog.outError("Database not specified in configuration file");
         return false;
     }
-    sLog.outString("World Database total connections: %i", nConnections + 1);
+    sLog.outString("World Database total connections: %i", nConnections + nAsyncConnections);
 
     ///- Initialise the world database
-    if (!WorldDatabase.Initialize(dbstring.c_str(), nConnections))
+    if (!WorldDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outError("Cannot connect to world database %s", dbstring.c_str());
         return false;
@@ -361,6 +367,7 @@ bool Master::_StartDB()
 
     dbstring = sConfig.GetStringDefault("CharacterDatabaseInfo");
     nConnections = sConfig.GetIntDefault("CharacterDatabaseConnections", 1);
+    nAsyncConnections = sConfig.GetIntDefault("CharacterDatabaseAsyncConnections", 1);
     if (dbstring.empty())
     {
         sLog.outError("Character Database not specified in configuration file");
@@ -369,10 +376,10 @@ bool Master::_StartDB()
         WorldDatabase.HaltDelayThread();
         return false;
     }
-    sLog.outString("Character Database total connections: %i", nConnections + 1);
+    sLog.outString("Character Database total connections: %i", nConnections + nAsyncConnections);
 
     ///- Initialise the Character database
-    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections))
+    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outError("Cannot connect to Character database %s", dbstring.c_str());
 
@@ -392,6 +399,7 @@ bool Master::_StartDB()
     ///- Get login database info from configuration file
     dbstring = sConfig.GetStringDefault("LoginDatabaseInfo");
     nConnections = sConfig.GetIntDefault("LoginDatabaseConnections", 1);
+    nAsyncConnections = sConfig.GetIntDefault("LoginDatabaseAsyncConnections", 1);
     if (dbstring.empty())
     {
         sLog.outError("Login database not specified in configuration file");
@@ -403,8 +411,8 @@ bool Master::_StartDB()
     }
 
     ///- Initialise the login database
-    sLog.outString("Login Database total connections: %i", nConnections + 1);
-    if (!LoginDatabase.Initialize(dbstring.c_str(), nConnections))
+    sLog.outString("Login Database total connections: %i", nConnections + nAsyncConnections);
+    if (!LoginDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outError("Cannot connect to login database %s", dbstring.c_str());
 
@@ -426,6 +434,7 @@ bool Master::_StartDB()
     ///- Get logs database info from configuration file
     dbstring = sConfig.GetStringDefault("LogsDatabaseInfo", "");
     nConnections = sConfig.GetIntDefault("LogsDatabaseConnections", 1);
+    nAsyncConnections = sConfig.GetIntDefault("LogsDatabaseAsyncConnections", 1);
     if (dbstring.empty())
     {
         sLog.outError("logs database not specified in configuration file");
@@ -438,8 +447,8 @@ bool Master::_StartDB()
     }
 
     ///- Initialise the logs database
-    sLog.outString("Logs Database total connections: %i", nConnections + 1);
-    if (!LogsDatabase.Initialize(dbstring.c_str(), nConnections))
+    sLog.outString("Logs Database total connections: %i", nConnections + nAsyncConnections);
+    if (!LogsDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outError("Cannot connect to logs database %s", dbstring.c_str());
 
@@ -97,7 +97,7 @@ Database::~Database()
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nDelayThreads /*= 1*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -139,6 +139,18 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
     if (!m_pAsyncConn->Initialize(infoString))
         return false;
 
+    for (int i = 1; i < std::min(nDelayThreads, MAX_CONNECTION_POOL_SIZE); ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pDelayConnections.push_back(pConn);
+    }
+
     m_pResultQueue = new SqlResultQueue;
 
     InitDelayThread();
@@ -155,36 +167,94 @@ void Database::StopServer()
     m_pResultQueue = nullptr;
     m_pAsyncConn = nullptr;
 
+    for (auto& m_pDelayConnection : m_pDelayConnections)
+        delete m_pDelayConnection;
+
+    m_pDelayConnections.clear();
+
     for (auto& m_pQueryConnection : m_pQueryConnections)
         delete m_pQueryConnection;
 
     m_pQueryConnections.clear();
 }
 
-SqlDelayThread* Database::CreateDelayThread()
+SqlDelayThread* Database::CreateDelayThread(SqlConnection* conn, bool pingDatabase)
 {
-    assert(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    assert(conn);
+    return new SqlDelayThread(this, conn, pingDatabase);
 }
 
 void Database::InitDelayThread()
 {
-    assert(!m_delayThread);
+    assert(m_delayThreads.empty());
+
+    // New delay threads for delay execute, the first one also keeps all connections of the database alive
+    m_threadBodies.push_back(CreateDelayThread(m_pAsyncConn, true));
+    for (SqlConnection* conn : m_pDelayConnections)
+        m_threadBodies.push_back(CreateDelayThread(conn, false));
 
-    // New delay thread for delay execute
-    m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
-    m_delayThread = new MaNGOS::Thread(m_threadBody);
+    for (SqlDelayThread* threadBody : m_threadBodies)
+        m_delayThreads.push_back(new MaNGOS::Thread(threadBody)); // threadBody will be deleted at thread delete
 }
 
 void Database::HaltDelayThread()
 {
-    if (!m_threadBody || !m_delayThread) return;
+    if (m_threadBodies.empty() || m_delayThreads.empty()) return;
+
+    for (SqlDelayThread* threadBody : m_threadBodies)
+        threadBody->Stop();                                 // Stop event
+
+    for (MaNGOS::Thread* delayThread : m_delayThreads)
+    {
+        delayThread->wait();                                // Wait for flush to DB
+        delete delayThread;                                 // This also deletes its thread body
+    }
+
+    m_delayThreads.clear();
+    m_threadBodies.clear();
+}
+
+static thread_local uint32 t_ownerKey = 0;
+
+uint32 Database::GetOwnerKey()
+{
+    return t_ownerKey;
+}
+
+void Database::SetOwnerKey(uint32 key)
+{
+    t_ownerKey = key;
+}
+
+SqlDelayThread* Database::getDelayThread() const
+{
+    if (m_threadBodies.size() == 1)
+        return m_threadBodies.front();
+
+    // requests of an owner always use the same delay thread, whichever server thread queues them
+    if (t_ownerKey)
+        return m_threadBodies[(t_ownerKey * 2654435761u) % m_threadBodies.size()];
+
+    // every other thread gets a fixed slot on first use, so its requests are executed in the order they were queued
+    static std::atomic<uint32> nextSlot(0);
+    thread_local uint32 slot = nextSlot++;
+    return m_threadBodies[slot % m_threadBodies.size()];
+}
+
+void Database::ConsumeDelayStatistics(uint64& queued, uint64& executed, uint64& waitTimeTotal, uint64& waitTimeMax)
+{
+    queued = executed = waitTimeTotal = waitTimeMax = 0;
+
+    for (SqlDelayThread* threadBody : m_threadBodies)
+    {
+        uint64 threadExecuted, threadWaitTotal, threadWaitMax;
+        threadBody->ConsumeStatistics(threadExecuted, threadWaitTotal, threadWaitMax);
 
-    m_threadBody->Stop();                                   // Stop event
-    m_delayThread->wait();                                  // Wait for flush to DB
-    delete m_delayThread;                                   // This also deletes m_threadBody
-    m_delayThread = nullptr;
-    m_threadBody = nullptr;
+        queued += threadBody->GetQueueSize();
+        executed += threadExecuted;
+        waitTimeTotal += threadWaitTotal;
+        waitTimeMax = std::max(waitTimeMax, threadWaitMax);
+    }
 }
 
 void Database::ThreadStart()
@@ -234,6 +304,12 @@ void Database::Ping()
         guard->Query(sql);
     }
 
+    for (auto& m_pDelayConnection : m_pDelayConnections)
+    {
+        SqlConnection::Lock guard(m_pDelayConnection);
+        guard->Query(sql);
+    }
+
     for (int i = 0; i < m_nQueryConnPoolSize; ++i)
     {
         SqlConnection::Lock guard(m_pQueryConnections[i]);
@@ -340,7 +416,7 @@ bool Database::Execute(const char* sql)
             return DirectExecute(sql);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPlainRequest(sql));
+        getDelayThread()->Delay(new SqlPlainRequest(sql));
     }
 
     return true;
@@ -409,7 +485,7 @@ bool Database::CommitTransaction()
         return CommitTransactionDirect();
 
     // add SqlTransaction to the async queue
-    m_threadBody->Delay(m_currentTransaction.release());
+    getDelayThread()->Delay(m_currentTransaction.release());
     return true;
 }
 
@@ -563,7 +639,7 @@ bool Database::ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params)
             return DirectExecuteStmt(id, params);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPreparedRequest(id.ID(), params));
+        getDelayThread()->Delay(new SqlPreparedRequest(id.ID(), params));
     }
 
     return true;
@@ -106,10 +106,11 @@ class Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char* infoString, int nConns = 1);
-        // start worker thread for async DB request execution
+        // nDelayThreads async connections execute delayed requests, requests queued from one thread always use the same one
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nDelayThreads = 1);
+        // start worker threads for async DB request execution
         virtual void InitDelayThread();
-        // stop worker thread
+        // stop worker threads
         virtual void HaltDelayThread();
 
         /// Synchronous DB queries
@@ -191,6 +192,10 @@ class Database
         // for sync transaction execution
         bool CommitTransactionDirect();
 
+        // owner (account) of the async requests the calling thread queues, 0 for none - see SqlOwnerScope
+        static uint32 GetOwnerKey();
+        static void SetOwnerKey(uint32 key);
+
         // PREPARED STATEMENT API
 
         // allocate index for prepared statement with SQL request 'fmt'
@@ -211,12 +216,23 @@ class Database
         // set database-wide result queue. also we should use object-bases and not thread-based result queues
         void ProcessResultQueue();
 
+        // async request statistics of all delay threads since the last call, wait times in microseconds
+        void ConsumeDelayStatistics(uint64& queued, uint64& executed, uint64& waitTimeTotal, uint64& waitTimeMax);
+
         bool CheckRequiredField(char const* table_name, char const* required_name);
         uint32 GetPingIntervall() const { return m_pingIntervallms; }
 
         // function to ping database connections
         void Ping();
 
+        // number of transactions rolled back or failed to commit so far, callers caching written state compare it between saves
+        uint32 GetFailedTransactionCount() const { return m_failedTransactions; }
+        void OnTransactionFailed() { ++m_failedTransactions; }
+
+        // MySQL 8.0.19+ accepts a row alias for ON DUPLICATE KEY UPDATE, VALUES() is deprecated there
+        bool HasInsertRowAlias() const { return m_insertRowAlias; }
+        void SetInsertRowAlias(bool value) { m_insertRowAlias = value; }
+
         // set this to allow async transactions
         // you should call it explicitly after your server successfully started up
         // NO ASYNC TRANSACTIONS DURING SERVER STARTUP - ONLY DURING RUNTIME!!!
@@ -225,7 +241,7 @@ class Database
     protected:
         Database() :
             m_nQueryConnPoolSize(1), m_pAsyncConn(nullptr), m_pResultQueue(nullptr),
-            m_threadBody(nullptr), m_delayThread(nullptr), m_allowAsyncTransactions(false),
+            m_allowAsyncTransactions(false), m_failedTransactions(0), m_insertRowAlias(false),
             m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
         {
             m_nQueryCounter = -1;
@@ -236,7 +252,7 @@ class Database
         // factory method to create SqlConnection objects
         virtual SqlConnection* CreateConnection() = 0;
         // factory method to create SqlDelayThread objects
-        virtual SqlDelayThread* CreateDelayThread();
+        virtual SqlDelayThread* CreateDelayThread(SqlConnection* conn, bool pingDatabase);
 
         // per-thread based storage for SqlTransaction object initialization - no locking is required
         boost::thread_specific_ptr<SqlTransaction> m_currentTransaction;
@@ -247,6 +263,8 @@ class Database
         SqlConnection* getQueryConnection();
         // for now return one single connection for async requests
         SqlConnection* getAsyncConnection() const { return m_pAsyncConn; }
+        // delay thread used by the calling thread, keeps requests of one thread in order
+        SqlDelayThread* getDelayThread() const;
 
         friend class SqlStatement;
         // PREPARED STATEMENT API
@@ -262,14 +280,18 @@ class Database
         typedef std::vector< SqlConnection* > SqlConnectionContainer;
         SqlConnectionContainer m_pQueryConnections;
 
-        // only one single DB connection for transactions
+        // DB connection for direct transactions, also used by the first delay thread
         SqlConnection* m_pAsyncConn;
+        // connections of the additional delay threads
+        SqlConnectionContainer m_pDelayConnections;
 
         SqlResultQueue*     m_pResultQueue;                 ///< Transaction queues from diff. threads
-        SqlDelayThread*     m_threadBody;                   ///< Pointer to delay sql executer (owned by m_delayThread)
-        MaNGOS::Thread*     m_delayThread;                  ///< Pointer to executer thread
+        std::vector<SqlDelayThread*> m_threadBodies;        ///< Delay sql executers (owned by m_delayThreads)
+        std::vector<MaNGOS::Thread*> m_delayThreads;        ///< Executer threads
 
         std::atomic<bool> m_allowAsyncTransactions;         ///< flag which specifies if async transactions are enabled
+        std::atomic<uint32> m_failedTransactions;           ///< failed transactions of all connections
+        bool m_insertRowAlias;                              ///< server supports INSERT ... AS alias, set while connecting
 
         // PREPARED STATEMENT REGISTRY
         typedef std::mutex LOCK_TYPE;
@@ -288,4 +310,19 @@ class Database
         std::string m_logsDir;
         uint32 m_pingIntervallms;
 };
+
+// Async requests queued while the scope lives are routed to the delay thread of the owner key instead of the one
+// of the calling thread, so requests of one owner keep their order whichever thread (world or map) queues them
+class SqlOwnerScope
+{
+    public:
+        explicit SqlOwnerScope(uint32 key) : m_previousKey(Database::GetOwnerKey()) { Database::SetOwnerKey(key); }
+        ~SqlOwnerScope() { Database::SetOwnerKey(m_previousKey); }
+
+        SqlOwnerScope(SqlOwnerScope const&) = delete;
+        SqlOwnerScope& operator=(SqlOwnerScope const&) = delete;
+
+    private:
+        uint32 m_previousKey;
+};
 #endif
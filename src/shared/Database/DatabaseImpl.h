@@ -54,7 +54,7 @@ Database::AsyncQuery(Class* object, void (Class::*method)(QueryResult*), const c
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, object);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return getDelayThread()->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
 }
 
 template<class Class, typename ParamType1>
@@ -63,7 +63,7 @@ Database::AsyncQuery(Class* object, void (Class::*method)(QueryResult*, ParamTyp
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, object, std::placeholders::_1, param1);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return getDelayThread()->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
 }
 
 template<class Class, typename ParamType1, typename ParamType2>
@@ -72,7 +72,7 @@ Database::AsyncQuery(Class* object, void (Class::*method)(QueryResult*, ParamTyp
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, object, std::placeholders::_1, param1, param2);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return getDelayThread()->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
 }
 
 template<class Class, typename ParamType1, typename ParamType2, typename ParamType3>
@@ -81,7 +81,7 @@ Database::AsyncQuery(Class* object, void (Class::*method)(QueryResult*, ParamTyp
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, object, std::placeholders::_1, param1, param2, param3);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return getDelayThread()->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
 }
 
 // -- Query / static --
@@ -92,7 +92,7 @@ Database::AsyncQuery(void (*method)(QueryResult*, ParamType1), ParamType1 param1
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, std::placeholders::_1, param1);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return getDelayThread()->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
 }
 
 template<typename ParamType1, typename ParamType2>
@@ -101,7 +101,7 @@ Database::AsyncQuery(void (*method)(QueryResult*, ParamType1, ParamType2), Param
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, std::placeholders::_1, param1, param2);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return getDelayThread()->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
 }
 
 template<typename ParamType1, typename ParamType2, typename ParamType3>
@@ -110,7 +110,7 @@ Database::AsyncQuery(void (*method)(QueryResult*, ParamType1, ParamType2, ParamT
 {
     ASYNC_QUERY_BODY(sql)
     auto callback = std::bind(method, std::placeholders::_1, param1, param2, param3);
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
+    return getDelayThread()->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback(std::move(callback)), m_pResultQueue));
 }
 
 // -- PQuery / member --
@@ -181,7 +181,7 @@ Database::DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, Sq
 {
     ASYNC_DELAYHOLDER_BODY(holder)
     auto callback = std::bind(method, object, std::placeholders::_1, holder);
-    return holder->Execute(new MaNGOS::QueryCallback(std::move(callback)), m_threadBody, m_pResultQueue);
+    return holder->Execute(new MaNGOS::QueryCallback(std::move(callback)), getDelayThread(), m_pResultQueue);
 }
 
 template<class Class, typename ParamType1>
@@ -190,7 +190,7 @@ Database::DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, Sq
 {
     ASYNC_DELAYHOLDER_BODY(holder)
     auto callback = std::bind(method, object, std::placeholders::_1, holder, param1);
-    return holder->Execute(new MaNGOS::QueryCallback(std::move(callback)), m_threadBody, m_pResultQueue);
+    return holder->Execute(new MaNGOS::QueryCallback(std::move(callback)), getDelayThread(), m_pResultQueue);
 }
 
 #undef ASYNC_QUERY_BODY
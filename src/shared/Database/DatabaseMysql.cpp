@@ -148,6 +148,10 @@ bool MySQLConnection::Initialize(const char* infoString)
     sLog.outString("MySQL client library: %s", mysql_get_client_info());
     sLog.outString("MySQL server ver: %s ", mysql_get_server_info(mMysql));
 
+    // MariaDB reports versions above 8.0.19 too, but only knows the VALUES() form
+    std::string serverInfo = mysql_get_server_info(mMysql);
+    DB().SetInsertRowAlias(mysql_get_server_version(mMysql) >= 80019 && serverInfo.find("MariaDB") == std::string::npos);
+
     /*----------SET AUTOCOMMIT ON---------*/
     // It seems mysql 5.0.x have enabled this feature
     // by default. In crash case you can lose data!!!
@@ -21,6 +21,7 @@
 
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/SQLStorageSnapshot.h"
 #include "DBCFileLoader.h"
 
 class SQLStorageBase
@@ -270,6 +271,25 @@ class SQLStorageLoaderBase
         void convert_str_to_str(uint32 field_pos, char* src, char*& dst);
 
     private:
+        // source rows come either from a query result or from a snapshot (see SQLStorageSnapshot)
+        struct FieldRow
+        {
+            explicit FieldRow(Field const* _fields) : fields(_fields) {}
+
+            uint32 GetId() const { return fields[0].GetUInt32(); }
+            uint32 GetUInt32(uint32 y) const { return fields[y].GetUInt32(); }
+            uint8 GetUInt8(uint32 y) const { return fields[y].GetUInt8(); }
+            float GetFloat(uint32 y) const { return fields[y].GetFloat(); }
+            uint64 GetUInt64(uint32 y) const { return fields[y].GetUInt64(); }
+            char const* GetString(uint32 y) const { return fields[y].GetString(); }
+
+            Field const* fields;
+        };
+
+        uint32 prepareStore(StorageClass& store, uint32 maxRecordId, uint32 recordCount);
+        template<class Row>
+        void storeRecord(StorageClass& store, Row& row);
+
         template<class V>
         void storeValue(V value, StorageClass& store, char* p, uint32 x, uint32& offset);
         void storeValue(char const* value, StorageClass& store, char* p, uint32 x, uint32& offset);
@@ -302,9 +302,144 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::storeValue(char const* v
     }
 }
 
+template<class DerivedLoader, class StorageClass>
+uint32 SQLStorageLoaderBase<DerivedLoader, StorageClass>::prepareStore(StorageClass& store, uint32 maxRecordId, uint32 recordCount)
+{
+    // get struct size
+    uint32 recordsize = 0;
+    for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
+    {
+        switch (store.GetDstFormat(x))
+        {
+            case FT_LOGIC:
+                recordsize += sizeof(bool);   break;
+            case FT_BYTE:
+                recordsize += sizeof(char);   break;
+            case FT_INT:
+                recordsize += sizeof(uint32); break;
+            case FT_FLOAT:
+                recordsize += sizeof(float);  break;
+            case FT_STRING:
+                recordsize += sizeof(char*);  break;
+            case FT_NA:
+                recordsize += sizeof(uint32); break;
+            case FT_NA_BYTE:
+                recordsize += sizeof(char);   break;
+            case FT_NA_FLOAT:
+                recordsize += sizeof(float);  break;
+            case FT_NA_POINTER:
+                recordsize += sizeof(char*);  break;
+            case FT_64BITINT:
+                recordsize += sizeof(uint64);  break;
+            case FT_IND:
+            case FT_SORT:
+                assert(false && "SQL storage not have sort field types");
+                break;
+            default:
+                assert(false && "unknown format character");
+                break;
+        }
+    }
+
+    // Prepare data storage and lookup storage
+    store.prepareToLoad(maxRecordId, recordCount, recordsize);
+    return recordsize;
+}
+
+template<class DerivedLoader, class StorageClass>
+template<class Row>
+void SQLStorageLoaderBase<DerivedLoader, StorageClass>::storeRecord(StorageClass& store, Row& row)
+{
+    char* record = store.createRecord(row.GetId());
+    uint32 offset = 0;
+
+    // dependend on dest-size
+    // iterate two indexes: x over dest, y over source
+    //                      y++ If and only If x != FT_NA*
+    //                      x++ If and only If a value is stored
+    for (uint32 x = 0, y = 0; x < store.GetDstFieldCount();)
+    {
+        switch (store.GetDstFormat(x))
+        {
+            // For default fill continue and do not increase y
+            case FT_NA:         storeValue((uint32)0, store, record, x, offset);         ++x; continue;
+            case FT_NA_BYTE:    storeValue((char)0, store, record, x, offset);           ++x; continue;
+            case FT_NA_FLOAT:   storeValue((float)0.0f, store, record, x, offset);       ++x; continue;
+            case FT_NA_POINTER: storeValue((char const*)nullptr, store, record, x, offset); ++x; continue;
+            default:
+                break;
+        }
+
+        // It is required that the input has at least as many columns set as the output requires
+        if (y >= store.GetSrcFieldCount())
+            assert(false && "SQL storage has too few columns!");
+
+        switch (store.GetSrcFormat(y))
+        {
+            case FT_LOGIC:  storeValue((bool)(row.GetUInt32(y) > 0), store, record, x, offset);  ++x; break;
+            case FT_BYTE:   storeValue((char)row.GetUInt8(y), store, record, x, offset);         ++x; break;
+            case FT_INT:    storeValue((uint32)row.GetUInt32(y), store, record, x, offset);      ++x; break;
+            case FT_FLOAT:  storeValue((float)row.GetFloat(y), store, record, x, offset);        ++x; break;
+            case FT_STRING: storeValue((char const*)row.GetString(y), store, record, x, offset); ++x; break;
+            case FT_64BITINT: storeValue((uint64)row.GetUInt64(y), store, record, x, offset);            ++x; break;
+            case FT_NA:
+            case FT_NA_BYTE:
+            case FT_NA_FLOAT:
+                // Do Not increase x
+                break;
+            case FT_IND:
+            case FT_SORT:
+            case FT_NA_POINTER:
+                assert(false && "SQL storage not have sort or pointer field types");
+                break;
+            default:
+                assert(false && "unknown format character");
+        }
+        ++y;
+    }
+}
+
 template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
+    // unchanged table, rows come from the snapshot written by an earlier load
+    SQLStorageSnapshot snapshot(store.GetTableName(), store.GetSrcFormat());
+    if (snapshot.Read())
+    {
+        prepareStore(store, snapshot.GetMaxRecordId(), snapshot.GetRecordCount());
+
+        bool valid = true;
+        try
+        {
+            BarGoLink bar(snapshot.GetRecordCount());
+            for (uint32 i = 0; i < snapshot.GetRecordCount() && valid; ++i)
+            {
+                bar.step();
+                valid = snapshot.NextRow();
+                if (valid)
+                {
+                    storeRecord(store, snapshot);
+                    valid = snapshot.IsRowConsumed();
+                }
+            }
+        }
+        catch (ByteBufferException const&)
+        {
+            valid = false;
+        }
+
+        if (valid)
+        {
+            DETAIL_LOG("Loaded %u rows of %s table from snapshot", snapshot.GetRecordCount(), store.GetTableName());
+            return;
+        }
+
+        // corrupt snapshot, drop what was stored from it and load the table from SQL
+        sLog.outError("World database snapshot of %s table is corrupt, loading from database.", store.GetTableName());
+        store.Free();
+        snapshot.Discard();
+    }
+
     Field* fields = nullptr;
     auto queryResult = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
     if (!queryResult)
@@ -316,7 +451,6 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
 
     uint32 maxRecordId = (*queryResult)[0].GetUInt32() + 1;
     uint32 recordCount = 0;
-    uint32 recordsize = 0;
 
     queryResult = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName());
     if (queryResult)
@@ -346,44 +480,7 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         exit(1);                                            // Stop server at loading broken or non-compatible table.
     }
 
-    // get struct size
-    uint32 offset = 0;
-    for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
-    {
-        switch (store.GetDstFormat(x))
-        {
-            case FT_LOGIC:
-                recordsize += sizeof(bool);   break;
-            case FT_BYTE:
-                recordsize += sizeof(char);   break;
-            case FT_INT:
-                recordsize += sizeof(uint32); break;
-            case FT_FLOAT:
-                recordsize += sizeof(float);  break;
-            case FT_STRING:
-                recordsize += sizeof(char*);  break;
-            case FT_NA:
-                recordsize += sizeof(uint32); break;
-            case FT_NA_BYTE:
-                recordsize += sizeof(char);   break;
-            case FT_NA_FLOAT:
-                recordsize += sizeof(float);  break;
-            case FT_NA_POINTER:
-                recordsize += sizeof(char*);  break;
-            case FT_64BITINT:
-                recordsize += sizeof(uint64);  break;
-            case FT_IND:
-            case FT_SORT:
-                assert(false && "SQL storage not have sort field types");
-                break;
-            default:
-                assert(false && "unknown format character");
-                break;
-        }
-    }
-
-    // Prepare data storage and lookup storage
-    store.prepareToLoad(maxRecordId, recordCount, recordsize);
+    prepareStore(store, maxRecordId, recordCount);
 
     BarGoLink bar(recordCount);
     do
@@ -391,55 +488,13 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         fields = queryResult->Fetch();
         bar.step();
 
-        char* record = store.createRecord(fields[0].GetUInt32());
-        offset = 0;
-
-        // dependend on dest-size
-        // iterate two indexes: x over dest, y over source
-        //                      y++ If and only If x != FT_NA*
-        //                      x++ If and only If a value is stored
-        for (uint32 x = 0, y = 0; x < store.GetDstFieldCount();)
-        {
-            switch (store.GetDstFormat(x))
-            {
-                // For default fill continue and do not increase y
-                case FT_NA:         storeValue((uint32)0, store, record, x, offset);         ++x; continue;
-                case FT_NA_BYTE:    storeValue((char)0, store, record, x, offset);           ++x; continue;
-                case FT_NA_FLOAT:   storeValue((float)0.0f, store, record, x, offset);       ++x; continue;
-                case FT_NA_POINTER: storeValue((char const*)nullptr, store, record, x, offset); ++x; continue;
-                default:
-                    break;
-            }
-
-            // It is required that the input has at least as many columns set as the output requires
-            if (y >= store.GetSrcFieldCount())
-                assert(false && "SQL storage has too few columns!");
-
-            switch (store.GetSrcFormat(y))
-            {
-                case FT_LOGIC:  storeValue((bool)(fields[y].GetUInt32() > 0), store, record, x, offset);  ++x; break;
-                case FT_BYTE:   storeValue((char)fields[y].GetUInt8(), store, record, x, offset);         ++x; break;
-                case FT_INT:    storeValue((uint32)fields[y].GetUInt32(), store, record, x, offset);      ++x; break;
-                case FT_FLOAT:  storeValue((float)fields[y].GetFloat(), store, record, x, offset);        ++x; break;
-                case FT_STRING: storeValue((char const*)fields[y].GetString(), store, record, x, offset); ++x; break;
-                case FT_64BITINT: storeValue((uint64)fields[y].GetUInt64(), store, record, x, offset);            ++x; break;
-                case FT_NA:
-                case FT_NA_BYTE:
-                case FT_NA_FLOAT:
-                    // Do Not increase x
-                    break;
-                case FT_IND:
-                case FT_SORT:
-                case FT_NA_POINTER:
-                    assert(false && "SQL storage not have sort or pointer field types");
-                    break;
-                default:
-                    assert(false && "unknown format character");
-            }
-            ++y;
-        }
+        FieldRow row(fields);
+        storeRecord(store, row);
+        snapshot.AppendRow(fields);
     }
     while (queryResult->NextRow());
+
+    snapshot.Write(maxRecordId);
 }
 
 #endif
@@ -0,0 +1,243 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Database/SQLStorageSnapshot.h"
+#include "Database/DatabaseEnv.h"
+#include "DBCFileLoader.h"
+#include "Platform/Filesystem.h"
+#include "Log/Log.h"
+
+#define SNAPSHOT_MAGIC      0x534C5153                      // "SQLS"
+#define SNAPSHOT_VERSION    1
+
+std::string SQLStorageSnapshot::s_directory;
+
+SQLStorageSnapshot::SQLStorageSnapshot(char const* tableName, char const* srcFormat) :
+    m_tableName(tableName), m_srcFormat(srcFormat), m_enabled(false), m_checksum(0),
+    m_maxRecordId(0), m_recordCount(0), m_nextRow(0), m_rowId(0), m_data(0)
+{
+}
+
+void SQLStorageSnapshot::SetDirectory(std::string const& directory)
+{
+    s_directory = directory;
+    if (s_directory.empty())
+        return;
+
+    boost::system::error_code error;
+    MaNGOS::Filesystem::create_directories(s_directory, error);
+    if (error)
+    {
+        sLog.outError("Can't create world database snapshot directory '%s': %s, snapshots disabled.", s_directory.c_str(), error.message().c_str());
+        s_directory.clear();
+    }
+}
+
+std::string SQLStorageSnapshot::GetFileName() const
+{
+    return s_directory + "/" + m_tableName + ".snapshot";
+}
+
+bool SQLStorageSnapshot::QueryChecksum()
+{
+#if defined(DO_POSTGRESQL) || defined(DO_SQLITE)
+    // no cheap content checksum available
+    return false;
+#else
+    auto queryResult = WorldDatabase.PQuery("CHECKSUM TABLE %s", m_tableName);
+    if (!queryResult || (*queryResult)[1].IsNULL())
+        return false;
+
+    m_checksum = (*queryResult)[1].GetUInt64();
+    return true;
+#endif
+}
+
+bool SQLStorageSnapshot::Read()
+{
+    if (s_directory.empty() || !QueryChecksum())
+        return false;
+
+    m_enabled = true;
+
+    FILE* in = fopen(GetFileName().c_str(), "rb");
+    if (!in)
+        return false;
+
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+
+    // read the whole file at once
+    m_data.resize(size > 0 ? size_t(size) : 0);
+    bool read = size > 0 && fread(const_cast<uint8*>(m_data.contents()), size_t(size), 1, in) == 1;
+    fclose(in);
+
+    try
+    {
+        if (!read || m_data.read<uint32>() != SNAPSHOT_MAGIC || m_data.read<uint32>() != SNAPSHOT_VERSION ||
+                m_data.read<uint64>() != m_checksum)
+        {
+            m_data.clear();
+            return false;
+        }
+
+        std::string srcFormat;
+        m_data >> srcFormat;
+        if (srcFormat != m_srcFormat)
+        {
+            m_data.clear();
+            return false;
+        }
+
+        m_maxRecordId = m_data.read<uint32>();
+        m_recordCount = m_data.read<uint32>();
+    }
+    catch (ByteBufferException const&)
+    {
+        m_data.clear();
+        return false;
+    }
+
+    m_nextRow = m_data.rpos();
+    m_enabled = false;                                      // up to date, nothing to write
+    return true;
+}
+
+bool SQLStorageSnapshot::NextRow()
+{
+    m_data.rpos(m_nextRow);
+    uint32 rowSize = m_data.read<uint32>();
+
+    // row must hold at least the record id and end inside the file
+    if (rowSize < sizeof(uint32) || rowSize > m_data.size() - m_data.rpos())
+        return false;
+
+    m_nextRow = m_data.rpos() + rowSize;
+    m_rowId = m_data.read<uint32>();
+    return m_rowId < m_maxRecordId;
+}
+
+char const* SQLStorageSnapshot::GetString(uint32 /*field*/)
+{
+    if (!m_data.read<uint8>())
+        return nullptr;
+
+    // terminator must be inside the current row
+    size_t pos = m_data.rpos();
+    char const* str = reinterpret_cast<char const*>(m_data.contents() + pos);
+    if (pos >= m_nextRow || !memchr(str, 0, m_nextRow - pos))
+        throw ByteBufferException(false, pos, m_nextRow > pos ? m_nextRow - pos : 0, m_nextRow);
+
+    m_data.read_skip(strlen(str) + 1);
+    return str;
+}
+
+void SQLStorageSnapshot::AppendRow(Field const* fields)
+{
+    if (!m_enabled)
+        return;
+
+    if (!m_recordCount)
+    {
+        m_data.clear();
+        m_data << uint32(SNAPSHOT_MAGIC) << uint32(SNAPSHOT_VERSION) << m_checksum;
+        m_data << m_srcFormat;
+        m_data << uint32(0) << uint32(0);                  // max record id and record count, set at write
+    }
+
+    // row size, put when the row is complete, and record id
+    size_t sizePos = m_data.wpos();
+    m_data << uint32(0) << fields[0].GetUInt32();
+
+    // same accessors as SQLStorageLoaderBase::Load uses for the source format
+    for (uint32 y = 0; m_srcFormat[y]; ++y)
+    {
+        switch (m_srcFormat[y])
+        {
+            case FT_LOGIC:
+            case FT_INT:
+                m_data << fields[y].GetUInt32();
+                break;
+            case FT_BYTE:
+                m_data << fields[y].GetUInt8();
+                break;
+            case FT_FLOAT:
+                m_data << fields[y].GetFloat();
+                break;
+            case FT_64BITINT:
+                m_data << fields[y].GetUInt64();
+                break;
+            case FT_STRING:
+                if (char const* str = fields[y].GetString())
+                    m_data << uint8(1) << str;
+                else
+                    m_data << uint8(0);
+                break;
+            default:
+                break;
+        }
+    }
+
+    m_data.put<uint32>(sizePos, uint32(m_data.wpos() - sizePos - sizeof(uint32)));
+    ++m_recordCount;
+}
+
+void SQLStorageSnapshot::Discard()
+{
+    m_data.clear();
+    m_maxRecordId = 0;
+    m_recordCount = 0;
+    m_nextRow = 0;
+    m_rowId = 0;
+    m_enabled = true;                                       // checksum is known, write the rows of the SQL load
+}
+
+void SQLStorageSnapshot::Write(uint32 maxRecordId)
+{
+    if (!m_enabled || !m_recordCount)
+        return;
+
+    // max record id and record count follow magic, version, checksum and the source format string
+    size_t countPos = sizeof(uint32) * 2 + sizeof(uint64) + strlen(m_srcFormat) + 1;
+    m_data.put<uint32>(countPos, maxRecordId);
+    m_data.put<uint32>(countPos + sizeof(uint32), m_recordCount);
+
+    // write to a temporary file first, a crash while writing must not leave a broken snapshot behind
+    std::string fileName = GetFileName();
+    std::string tmpFileName = fileName + ".tmp";
+    FILE* out = fopen(tmpFileName.c_str(), "wb");
+    if (!out)
+    {
+        sLog.outError("Can't write world database snapshot '%s'.", tmpFileName.c_str());
+        return;
+    }
+
+    bool written = fwrite(m_data.contents(), m_data.wpos(), 1, out) == 1;
+    fclose(out);
+
+    boost::system::error_code error;
+    if (written)
+        MaNGOS::Filesystem::rename(tmpFileName, fileName, error);
+
+    if (!written || error)
+    {
+        sLog.outError("Can't write world database snapshot '%s'.", fileName.c_str());
+        MaNGOS::Filesystem::remove(tmpFileName, error);
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SQLSTORAGE_SNAPSHOT_H
+#define SQLSTORAGE_SNAPSHOT_H
+
+#include "Common.h"
+#include "Util/ByteBuffer.h"
+
+class Field;
+
+// Binary copy of the source rows of a world database table used by SQLStorage
+// The rows are stored as the database returned them (before any loader conversion) so a load
+// from the snapshot runs the same conversions as a load from SQL. A snapshot is only used
+// while the table checksum reported by the database still matches the one it was written with.
+class SQLStorageSnapshot
+{
+    public:
+        SQLStorageSnapshot(char const* tableName, char const* srcFormat);
+
+        // directory the snapshots are kept in, empty disables them
+        static void SetDirectory(std::string const& directory);
+
+        // read the snapshot of the table, false if snapshots are disabled or it's missing or stale
+        bool Read();
+
+        uint32 GetMaxRecordId() const { return m_maxRecordId; }
+        uint32 GetRecordCount() const { return m_recordCount; }
+
+        // row access, fields must be read in increasing order
+        // a row with a bad size or record id is rejected, reads past the row throw ByteBufferException
+        bool NextRow();
+        bool IsRowConsumed() const { return m_data.rpos() == m_nextRow; }
+        uint32 GetId() const { return m_rowId; }
+        uint32 GetUInt32(uint32 /*field*/) { return m_data.read<uint32>(); }
+        uint8 GetUInt8(uint32 /*field*/) { return m_data.read<uint8>(); }
+        float GetFloat(uint32 /*field*/) { return m_data.read<float>(); }
+        uint64 GetUInt64(uint32 /*field*/) { return m_data.read<uint64>(); }
+        char const* GetString(uint32 field);
+
+        // collect the rows of a load from SQL and write them as the new snapshot
+        void AppendRow(Field const* fields);
+        void Write(uint32 maxRecordId);
+
+        // drop a snapshot found corrupt while reading rows, the SQL load that follows rewrites it
+        void Discard();
+
+    private:
+        bool QueryChecksum();
+        std::string GetFileName() const;
+
+        static std::string s_directory;
+
+        char const* m_tableName;
+        char const* m_srcFormat;
+        bool m_enabled;                                     // checksum known, rows are collected for writing
+        uint64 m_checksum;
+
+        uint32 m_maxRecordId;
+        uint32 m_recordCount;
+        size_t m_nextRow;
+        uint32 m_rowId;
+        ByteBuffer m_data;
+};
+
+#endif
@@ -20,7 +20,8 @@
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase) : m_dbEngine(db), m_dbConnection(conn),
+    m_pingDatabase(pingDatabase), m_running(true), m_executedCount(0), m_waitTimeTotal(0), m_waitTimeMax(0)
 {
 }
 
@@ -38,23 +39,26 @@ void SqlDelayThread::run()
 #endif
 #endif
 
-    const uint32 loopSleepms = 10;
+    const std::chrono::milliseconds pingInterval(std::max<uint32>(m_dbEngine->GetPingIntervall(), 1000));
 
-    const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
-
-    uint32 loopCounter = 0;
+    Clock::time_point nextPing = Clock::now() + pingInterval;
     while (m_running)
     {
-        // if the running state gets turned off while sleeping
-        // empty the queue before exiting
-        MaNGOS::Thread::Sleep(loopSleepms);
+        // woken up by Delay() and Stop(), the timeout only serves the connection ping
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCondition.wait_until(lock, nextPing, [this] { return !m_sqlQueue.empty() || !m_running; });
+        }
 
+        // if the running state gets turned off while waiting
+        // empty the queue before exiting
         ProcessRequests();
 
-        if ((loopCounter++) >= pingEveryLoop)
+        if (Clock::now() >= nextPing)
         {
-            loopCounter = 0;
-            m_dbEngine->Ping();
+            nextPing = Clock::now() + pingInterval;
+            if (m_pingDatabase)
+                m_dbEngine->Ping();
         }
     }
 
@@ -67,12 +71,16 @@ void SqlDelayThread::run()
 
 void SqlDelayThread::Stop()
 {
-    m_running = false;
+    {
+        std::lock_guard<std::mutex> guard(m_queueMutex);
+        m_running = false;
+    }
+    m_queueCondition.notify_all();
 }
 
 void SqlDelayThread::ProcessRequests()
 {
-    std::queue<std::unique_ptr<SqlOperation>> sqlQueue;
+    std::queue<DelayedOperation> sqlQueue;
 
     // we need to move the contents of the queue to a local copy because executing these statements with the
     // lock in place can result in a deadlock with the world thread which calls Database::ProcessResultQueue()
@@ -83,8 +91,22 @@ void SqlDelayThread::ProcessRequests()
 
     while (!sqlQueue.empty())
     {
-        auto const s = std::move(sqlQueue.front());
+        DelayedOperation s = std::move(sqlQueue.front());
         sqlQueue.pop();
-        s->Execute(m_dbConnection);
+
+        uint64 waitTime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - s.queued).count();
+        m_waitTimeTotal += waitTime;
+        uint64 waitTimeMax = m_waitTimeMax;
+        while (waitTime > waitTimeMax && !m_waitTimeMax.compare_exchange_weak(waitTimeMax, waitTime)) {}
+        ++m_executedCount;
+
+        s.operation->Execute(m_dbConnection);
     }
 }
+
+void SqlDelayThread::ConsumeStatistics(uint64& executed, uint64& waitTimeTotal, uint64& waitTimeMax)
+{
+    executed = m_executedCount.exchange(0);
+    waitTimeTotal = m_waitTimeTotal.exchange(0);
+    waitTimeMax = m_waitTimeMax.exchange(0);
+}
@@ -23,6 +23,8 @@
 #include "SqlOperations.h"
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -34,27 +36,54 @@ class SqlConnection;
 class SqlDelayThread : public MaNGOS::Runnable
 {
     private:
+        typedef std::chrono::steady_clock Clock;
+
+        struct DelayedOperation
+        {
+            std::unique_ptr<SqlOperation> operation;
+            Clock::time_point queued;
+        };
+
         std::mutex m_queueMutex;
-        std::queue<std::unique_ptr<SqlOperation>> m_sqlQueue;   ///< Queue of SQL statements
+        std::condition_variable m_queueCondition;               ///< Signalled on new requests and on stop
+        std::queue<DelayedOperation> m_sqlQueue;                ///< Queue of SQL statements
         Database* m_dbEngine;                                   ///< Pointer to used Database engine
         SqlConnection* m_dbConnection;                          ///< Pointer to DB connection
+        bool m_pingDatabase;                                    ///< Only one thread of a database pings its connections
         std::atomic<bool> m_running;
 
+        // statistics since last ConsumeStatistics call
+        std::atomic<uint64> m_executedCount;
+        std::atomic<uint64> m_waitTimeTotal;                    ///< Microseconds from Delay() to execution
+        std::atomic<uint64> m_waitTimeMax;
+
         // process all enqueued requests
         void ProcessRequests();
 
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase = true);
         ~SqlDelayThread();
 
         ///< Put sql statement to delay queue
         bool Delay(SqlOperation* sql)
         {
-            std::lock_guard<std::mutex> guard(m_queueMutex);
-            m_sqlQueue.push(std::unique_ptr<SqlOperation>(sql));
+            {
+                std::lock_guard<std::mutex> guard(m_queueMutex);
+                m_sqlQueue.push({ std::unique_ptr<SqlOperation>(sql), Clock::now() });
+            }
+            m_queueCondition.notify_one();
             return true;
         }
 
+        size_t GetQueueSize()
+        {
+            std::lock_guard<std::mutex> guard(m_queueMutex);
+            return m_sqlQueue.size();
+        }
+
+        // executed requests, total and maximum time they waited in the queue (microseconds) since the last call
+        void ConsumeStatistics(uint64& executed, uint64& waitTimeTotal, uint64& waitTimeMax);
+
         virtual void Stop();                                ///< Stop event
         virtual void run();                                 ///< Main Thread loop
 };
@@ -60,11 +60,18 @@ bool SqlTransaction::Execute(SqlConnection* conn)
         if (!pStmt->Execute(conn))
         {
             conn->RollbackTransaction();
+            conn->DB().OnTransactionFailed();
             return false;
         }
     }
 
-    return conn->CommitTransaction();
+    if (!conn->CommitTransaction())
+    {
+        conn->DB().OnTransactionFailed();
+        return false;
+    }
+
+    return true;
 }
 
 SqlPreparedRequest::SqlPreparedRequest(int nIndex, SqlStmtParameters* arg) : m_nIndex(nIndex), m_param(arg)
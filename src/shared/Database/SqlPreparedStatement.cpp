@@ -34,6 +34,109 @@ void SqlStmtParameters::reset(const SqlStatement& stmt)
 }
 
 //////////////////////////////////////////////////////////////////////////
+SqlBatchInsert::SqlBatchInsert(Database& db, SqlBatchStatementID& index, const char* table, const char* columns, const char* keyColumns) :
+    m_db(db), m_index(index), m_table(table), m_checksum(14695981039346656037ULL)
+{
+    auto split = [](const char* list, std::vector<std::string>& result)
+    {
+        std::stringstream ss(list);
+        std::string column;
+        while (std::getline(ss, column, ','))
+        {
+            column.erase(0, column.find_first_not_of(' '));
+            column.erase(column.find_last_not_of(' ') + 1);
+            result.push_back(column);
+        }
+    };
+
+    split(columns, m_columns);
+    if (keyColumns)
+        split(keyColumns, m_keyColumns);
+
+    MANGOS_ASSERT(!m_columns.empty());
+}
+
+std::string SqlBatchInsert::BuildStatement(uint32 rows) const
+{
+    std::string row = "(?";
+    for (size_t i = 1; i < m_columns.size(); ++i)
+        row += ", ?";
+    row += ")";
+
+    std::string sql = "INSERT INTO " + m_table + " (";
+    for (size_t i = 0; i < m_columns.size(); ++i)
+        sql += (i ? ", " : "") + m_columns[i];
+    sql += ") VALUES ";
+
+    for (uint32 i = 0; i < rows; ++i)
+        sql += (i ? ", " : "") + row;
+
+    if (m_keyColumns.empty())
+        return sql;
+
+    std::vector<std::string> updated;
+    for (std::string const& column : m_columns)
+        if (std::find(m_keyColumns.begin(), m_keyColumns.end(), column) == m_keyColumns.end())
+            updated.push_back(column);
+
+#if defined(DO_POSTGRESQL) || defined(DO_SQLITE)
+    sql += " ON CONFLICT (";
+    for (size_t i = 0; i < m_keyColumns.size(); ++i)
+        sql += (i ? ", " : "") + m_keyColumns[i];
+    sql += ")";
+
+    if (updated.empty())
+        return sql + " DO NOTHING";
+
+    sql += " DO UPDATE SET ";
+    for (size_t i = 0; i < updated.size(); ++i)
+        sql += (i ? ", " : "") + updated[i] + " = excluded." + updated[i];
+#else
+    // a key only row still needs an assignment to make the duplicate a no-op
+    if (updated.empty())
+        updated.push_back(m_keyColumns.front());
+
+    if (m_db.HasInsertRowAlias())
+    {
+        sql += " AS new_row ON DUPLICATE KEY UPDATE ";
+        for (size_t i = 0; i < updated.size(); ++i)
+            sql += (i ? ", " : "") + updated[i] + " = new_row." + updated[i];
+    }
+    else
+    {
+        sql += " ON DUPLICATE KEY UPDATE ";
+        for (size_t i = 0; i < updated.size(); ++i)
+            sql += (i ? ", " : "") + updated[i] + " = VALUES(" + updated[i] + ")";
+    }
+#endif
+
+    return sql;
+}
+
+uint32 SqlBatchInsert::Execute()
+{
+    uint32 rows = GetRowCount();
+
+    for (uint32 done = 0; done < rows;)
+    {
+        uint32 chunk = std::min<uint32>(rows - done, SQL_BATCH_MAX_ROWS);
+
+        SqlStatementID& id = m_index[chunk];
+        SqlStatement stmt = id.initialized() ? m_db.CreateStatement(id, nullptr) : m_db.CreateStatement(id, BuildStatement(chunk).c_str());
+
+        size_t first = done * m_columns.size();
+        size_t last = (done + chunk) * m_columns.size();
+        for (size_t i = first; i < last; ++i)
+            stmt.addField(m_params[i]);
+
+        stmt.Execute();
+        done += chunk;
+    }
+
+    m_params.clear();
+    return rows;
+}
+
 SqlStatement& SqlStatement::operator=(const SqlStatement& index)
 {
     if (this != &index)
@@ -253,6 +253,7 @@ class SqlStatement
         void addString(const char* var) { arg(var); }
         void addString(const std::string& var) { arg(var.c_str()); }
         void addString(std::ostringstream& ss) { arg(ss.str().c_str()); ss.str(std::string()); }
+        void addField(const SqlStmtFieldData& data) { get()->addParam(data); }
 
     protected:
         // don't allow anyone except Database class to create static SqlStatement objects
@@ -290,6 +291,74 @@ class SqlStatement
         SqlStmtParameters* m_pParams;
 };
 
+// most rows sent with a single multi-row INSERT statement
+#define SQL_BATCH_MAX_ROWS 16
+
+// statement ids of a batched insert, one per amount of rows
+class SqlBatchStatementID
+{
+    public:
+        SqlStatementID& operator[](uint32 rows) { return m_ids[rows - 1]; }
+
+    private:
+        SqlStatementID m_ids[SQL_BATCH_MAX_ROWS];
+};
+
+// collects the rows of an INSERT and executes them as multi-row statements
+// with key columns set the rows replace existing ones (upsert), non key columns being updated
+class SqlBatchInsert
+{
+    public:
+        SqlBatchInsert(Database& db, SqlBatchStatementID& index, const char* table, const char* columns, const char* keyColumns = nullptr);
+
+        // bind values of the rows, column by column
+        SqlBatchInsert& addBool(bool var) { return add(var); }
+        SqlBatchInsert& addUInt8(uint8 var) { return add(var); }
+        SqlBatchInsert& addInt8(int8 var) { return add(var); }
+        SqlBatchInsert& addUInt16(uint16 var) { return add(var); }
+        SqlBatchInsert& addInt16(int16 var) { return add(var); }
+        SqlBatchInsert& addUInt32(uint32 var) { return add(var); }
+        SqlBatchInsert& addInt32(int32 var) { return add(var); }
+        SqlBatchInsert& addUInt64(uint64 var) { return add(var); }
+        SqlBatchInsert& addInt64(int64 var) { return add(var); }
+        SqlBatchInsert& addFloat(float var) { return add(var); }
+        SqlBatchInsert& addDouble(double var) { return add(var); }
+        SqlBatchInsert& addString(const char* var) { return add(var); }
+        SqlBatchInsert& addString(const std::string& var) { return add(var.c_str()); }
+        SqlBatchInsert& addString(std::ostringstream& ss) { add(ss.str().c_str()); ss.str(std::string()); return *this; }
+
+        uint32 GetRowCount() const { return m_params.size() / m_columns.size(); }
+        // checksum of all bound values, allows to skip writing rows which are known to be persisted already
+        uint64 GetChecksum() const { return m_checksum; }
+
+        // executes all complete rows, returns amount of rows sent
+        uint32 Execute();
+
+    private:
+        template<typename ParamType>
+        SqlBatchInsert& add(ParamType val)
+        {
+            m_params.emplace_back(val);
+            SqlStmtFieldData const& data = m_params.back();
+
+            // FNV-1a
+            m_checksum = (m_checksum ^ data.type()) * 1099511628211ULL;
+            for (size_t i = 0; i < data.size(); ++i)
+                m_checksum = (m_checksum ^ static_cast<uint8 const*>(data.buff())[i]) * 1099511628211ULL;
+            return *this;
+        }
+
+        std::string BuildStatement(uint32 rows) const;
+
+        Database& m_db;
+        SqlBatchStatementID& m_index;
+        std::string m_table;
+        std::vector<std::string> m_columns;
+        std::vector<std::string> m_keyColumns;
+        std::vector<SqlStmtFieldData> m_params;
+        uint64 m_checksum;
+};
+
 // base prepared statement class
 class SqlPreparedStatement
 {
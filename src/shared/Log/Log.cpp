@@ -68,13 +68,171 @@ enum LogType
 
 const int LogType_count = int(LogError) + 1;
 
+// Where a message goes to
+enum LogTarget
+{
+    LOG_TARGET_STDOUT       = 0x0001,
+    LOG_TARGET_STDERR       = 0x0002,
+    LOG_TARGET_LOGFILE      = 0x0004,                       // gets the message prefix
+    LOG_TARGET_GMLOG        = 0x0008,                       // account specific file with GmLogPerAccount
+    LOG_TARGET_CHARLOG      = 0x0010,
+    LOG_TARGET_DBERRLOG     = 0x0020,
+    LOG_TARGET_EVENTAIERRLOG = 0x0040,
+    LOG_TARGET_SCRIPTERRLOG = 0x0080,
+    LOG_TARGET_RALOG        = 0x0100,
+    LOG_TARGET_WORLDLOG     = 0x0200,
+    LOG_TARGET_CUSTOMLOG    = 0x0400,
+};
+
+enum LogMessageFlags
+{
+    LOG_MESSAGE_PADDING      = 0x01,                        // unused end of a ring buffer
+    LOG_MESSAGE_NO_TIMESTAMP = 0x02,                        // written as is (dumps, traces)
+    LOG_MESSAGE_PACKET       = 0x04,                        // data is a packet to be dumped in hex
+};
+
+#define LOG_WRITER_INTERVAL 10                              // ms between writer passes if nobody wakes it up
+
+// Message header, followed by the zero terminated prefix, the zero terminated text and the raw data
+struct Log::LogMessage
+{
+    uint32 size;                                            // whole record, multiple of 8
+    uint32 flags;
+    uint64 sequence;
+    time_t time;
+    uint32 targets;
+    int32 color;                                            // LogType, -1 for none
+    uint32 account;
+    uint32 prefixLength;
+    uint32 textLength;
+    uint32 dataLength;
+
+    char const* Prefix() const { return reinterpret_cast<char const*>(this + 1); }
+    char const* Text() const { return Prefix() + prefixLength + 1; }
+    uint8 const* Data() const { return reinterpret_cast<uint8 const*>(Text() + textLength + 1); }
+
+    static uint32 RecordSize(uint32 prefixLength, uint32 textLength, uint32 dataLength)
+    {
+        return (sizeof(LogMessage) + prefixLength + 1 + textLength + 1 + dataLength + 7) & ~7u;
+    }
+};
+
+// Single producer (owning thread) / single consumer (writer thread) buffer of variable sized messages
+class LogRingBuffer
+{
+    public:
+        explicit LogRingBuffer(uint32 capacity) : m_data(new uint64[capacity / sizeof(uint64)]), m_capacity(capacity),
+            m_head(0), m_tail(0), m_reserved(0), m_abandoned(false) {}
+
+        uint32 GetCapacity() const { return m_capacity; }
+        bool IsEmpty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire); }
+        bool IsHalfFull() const { return m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_relaxed) > m_capacity / 2; }
+
+        // producer side, the record has to be contiguous so the rest of the buffer is skipped if it does not fit at the end
+        char* Reserve(uint32 size)
+        {
+            uint64 head = m_head.load(std::memory_order_relaxed);
+            uint64 tail = m_tail.load(std::memory_order_acquire);
+            uint32 offset = uint32(head % m_capacity);
+            uint32 toEnd = m_capacity - offset;
+            uint32 needed = size > toEnd ? toEnd + size : size;
+            if (head + needed - tail > m_capacity)
+                return nullptr;
+
+            if (size > toEnd)
+            {
+                Log::LogMessage* padding = reinterpret_cast<Log::LogMessage*>(Bytes() + offset);
+                padding->size = toEnd;
+                padding->flags = LOG_MESSAGE_PADDING;
+                head += toEnd;
+                offset = 0;
+            }
+
+            m_reserved = head;
+            return Bytes() + offset;
+        }
+
+        void Commit(uint32 size) { m_head.store(m_reserved + size, std::memory_order_release); }
+
+        // consumer side
+        template<typename F>
+        void Drain(F&& handler)
+        {
+            uint64 tail = m_tail.load(std::memory_order_relaxed);
+            uint64 head = m_head.load(std::memory_order_acquire);
+            while (tail < head)
+            {
+                Log::LogMessage const* message = reinterpret_cast<Log::LogMessage const*>(Bytes() + tail % m_capacity);
+                if (!(message->flags & LOG_MESSAGE_PADDING))
+                    handler(*message);
+                tail += message->size;
+            }
+            m_tail.store(tail, std::memory_order_release);
+        }
+
+        void Abandon() { m_abandoned.store(true, std::memory_order_release); }
+        bool IsAbandoned() const { return m_abandoned.load(std::memory_order_acquire); }
+
+    private:
+        char* Bytes() { return reinterpret_cast<char*>(m_data.get()); }
+
+        std::unique_ptr<uint64[]> m_data;
+        uint32 m_capacity;                                  // power of two
+        std::atomic<uint64> m_head;                         // total bytes committed
+        std::atomic<uint64> m_tail;                         // total bytes consumed
+        uint64 m_reserved;
+        std::atomic<bool> m_abandoned;                      // owning thread exited
+};
+
 Log::Log() :
     raLogfile(nullptr), logfile(nullptr), gmLogfile(nullptr), charLogfile(nullptr), dberLogfile(nullptr),
-    eventAiErLogfile(nullptr), scriptErrLogFile(nullptr), worldLogfile(nullptr), customLogFile(nullptr), m_colored(false), m_includeTime(false), m_gmlog_per_account(false), m_scriptLibName(nullptr)
+    eventAiErLogfile(nullptr), scriptErrLogFile(nullptr), worldLogfile(nullptr), customLogFile(nullptr), m_colored(false), m_includeTime(false), m_gmlog_per_account(false), m_scriptLibName(nullptr),
+    m_async(false), m_asyncBlock(false), m_asyncBufferSize(0), m_asyncRunning(false), m_asyncProducers(0), m_sequence(0), m_dropped(0), m_writerStop(false)
 {
     Initialize();
 }
 
+Log::~Log()
+{
+    StopAsync();
+
+    if (logfile != nullptr)
+        fclose(logfile);
+    logfile = nullptr;
+
+    if (gmLogfile != nullptr)
+        fclose(gmLogfile);
+    gmLogfile = nullptr;
+
+    if (charLogfile != nullptr)
+        fclose(charLogfile);
+    charLogfile = nullptr;
+
+    if (dberLogfile != nullptr)
+        fclose(dberLogfile);
+    dberLogfile = nullptr;
+
+    if (eventAiErLogfile != nullptr)
+        fclose(eventAiErLogfile);
+    eventAiErLogfile = nullptr;
+
+    if (scriptErrLogFile != nullptr)
+        fclose(scriptErrLogFile);
+    scriptErrLogFile = nullptr;
+
+    if (raLogfile != nullptr)
+        fclose(raLogfile);
+    raLogfile = nullptr;
+
+    if (worldLogfile != nullptr)
+        fclose(worldLogfile);
+    worldLogfile = nullptr;
+
+    if (customLogFile != nullptr)
+        fclose(customLogFile);
+    customLogFile = nullptr;
+}
+
 void Log::InitColors(const std::string& str)
 {
     if (str.empty())
@@ -287,6 +445,12 @@ void Log::Initialize()
 
     // Char log settings
     m_charLog_Dump = sConfig.GetBoolDefault("CharLogDump", false);
+
+    // Asynchronous output settings, applied by StartAsync
+    m_async = sConfig.GetBoolDefault("LogAsync", false);
+    m_asyncBlock = sConfig.GetBoolDefault("LogAsyncBlock", false);
+    uint32 bufferSize = std::max(sConfig.GetIntDefault("LogAsyncBufferSize", 256), 16) * 1024;
+    for (m_asyncBufferSize = 1; m_asyncBufferSize < bufferSize; m_asyncBufferSize <<= 1);
 }
 
 FILE* Log::openLogFile(char const* configFileName, char const* configTimeStampFlag, char const* mode)
@@ -319,7 +483,11 @@ FILE* Log::openGmlogPerAccount(uint32 account)
 
 void Log::outTimestamp(FILE* file)
 {
-    time_t t = time(nullptr);
+    outTimestamp(file, time(nullptr));
+}
+
+void Log::outTimestamp(FILE* file, time_t t)
+{
     tm* aTm = localtime(&t);
     //       YYYY   year
     //       MM     month (2 digits 01-12)
@@ -332,7 +500,11 @@ void Log::outTimestamp(FILE* file)
 
 void Log::outTime() const
 {
-    time_t t = time(nullptr);
+    outTime(time(nullptr));
+}
+
+void Log::outTime(time_t t) const
+{
     tm* aTm = localtime(&t);
     //       YYYY   year
     //       MM     month (2 digits 01-12)
@@ -362,18 +534,7 @@ std::string Log::GetTimestampStr()
 
 void Log::outString()
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_includeTime)
-        outTime();
-    printf("\n");
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
-
-    fflush(stdout);
+    Submit(LOG_TARGET_STDOUT | (logfile ? LOG_TARGET_LOGFILE : 0), -1, 0, 0, "", "", 0);
 }
 
 void Log::outString(const char* str, ...)
@@ -381,38 +542,10 @@ void Log::outString(const char* str, ...)
     if (!str)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-
-    if (m_colored)
-        SetColor(true, m_colors[LogNormal]);
-
-    if (m_includeTime)
-        outTime();
-
     va_list ap;
-
     va_start(ap, str);
-    vutf8printf(stdout, str, &ap);
+    SubmitFormatted(LOG_TARGET_STDOUT | (logfile ? LOG_TARGET_LOGFILE : 0), LogNormal, 0, "", str, ap);
     va_end(ap);
-
-    if (m_colored)
-        ResetColor(true);
-
-    printf("\n");
-
-    if (logfile)
-    {
-        outTimestamp(logfile);
-
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
-        va_end(ap);
-
-        fflush(logfile);
-    }
-
-    fflush(stdout);
 }
 
 void Log::outError(const char* err, ...)
@@ -420,64 +553,15 @@ void Log::outError(const char* err, ...)
     if (!err)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-
-    if (m_colored)
-        SetColor(false, m_colors[LogError]);
-
-    if (m_includeTime)
-        outTime();
-
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    SubmitFormatted(LOG_TARGET_STDERR | (logfile ? LOG_TARGET_LOGFILE : 0), LogError, 0, "ERROR:", err, ap);
     va_end(ap);
-
-    if (m_colored)
-        ResetColor(false);
-
-    fprintf(stderr, "\n");
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:");
-
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
-
-    fflush(stderr);
 }
 
 void Log::outErrorDb()
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-
-    if (m_includeTime)
-        outTime();
-
-    fprintf(stderr, "\n");
-
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:\n");
-        fflush(logfile);
-    }
-
-    if (dberLogfile)
-    {
-        outTimestamp(dberLogfile);
-        fprintf(dberLogfile, "\n");
-        fflush(dberLogfile);
-    }
-
-    fflush(stderr);
+    Submit(LOG_TARGET_STDERR | (logfile ? LOG_TARGET_LOGFILE : 0) | (dberLogfile ? LOG_TARGET_DBERRLOG : 0), -1, 0, 0, "ERROR:", "", 0);
 }
 
 void Log::outErrorDb(const char* err, ...)
@@ -485,492 +569,518 @@ void Log::outErrorDb(const char* err, ...)
     if (!err)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
+    va_list ap;
+    va_start(ap, err);
+    SubmitFormatted(LOG_TARGET_STDERR | (logfile ? LOG_TARGET_LOGFILE : 0) | (dberLogfile ? LOG_TARGET_DBERRLOG : 0), LogError, 0, "ERROR:", err, ap);
+    va_end(ap);
+}
 
-    if (m_colored)
-        SetColor(false, m_colors[LogError]);
+void Log::outErrorEventAI()
+{
+    Submit(LOG_TARGET_STDERR | (logfile ? LOG_TARGET_LOGFILE : 0) | (eventAiErLogfile ? LOG_TARGET_EVENTAIERRLOG : 0), -1, 0, 0, "ERROR CreatureEventAI", "", 0);
+}
 
-    if (m_includeTime)
-        outTime();
+void Log::outErrorEventAI(const char* err, ...)
+{
+    if (!err)
+        return;
 
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    SubmitFormatted(LOG_TARGET_STDERR | (logfile ? LOG_TARGET_LOGFILE : 0) | (eventAiErLogfile ? LOG_TARGET_EVENTAIERRLOG : 0), LogError, 0, "ERROR CreatureEventAI: ", err, ap);
     va_end(ap);
+}
 
-    if (m_colored)
-        ResetColor(false);
+void Log::outBasic(const char* str, ...)
+{
+    if (!str)
+        return;
 
-    fprintf(stderr, "\n");
+    uint32 targets = (m_logLevel >= LOG_LVL_BASIC ? LOG_TARGET_STDOUT : 0) | (logfile && m_logFileLevel >= LOG_LVL_BASIC ? LOG_TARGET_LOGFILE : 0);
+    if (!targets)
+        return;
 
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:");
+    va_list ap;
+    va_start(ap, str);
+    SubmitFormatted(targets, LogDetails, 0, "", str, ap);
+    va_end(ap);
+}
 
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
+void Log::outDetail(const char* str, ...)
+{
+    if (!str)
+        return;
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
+    uint32 targets = (m_logLevel >= LOG_LVL_DETAIL ? LOG_TARGET_STDOUT : 0) | (logfile && m_logFileLevel >= LOG_LVL_DETAIL ? LOG_TARGET_LOGFILE : 0);
+    if (!targets)
+        return;
 
-    if (dberLogfile)
-    {
-        outTimestamp(dberLogfile);
+    va_list ap;
+    va_start(ap, str);
+    SubmitFormatted(targets, LogDetails, 0, "", str, ap);
+    va_end(ap);
+}
 
-        va_list ap;
-        va_start(ap, err);
-        vfprintf(dberLogfile, err, ap);
-        va_end(ap);
+void Log::outDebug(const char* str, ...)
+{
+    if (!str)
+        return;
 
-        fprintf(dberLogfile, "\n");
-        fflush(dberLogfile);
-    }
+    uint32 targets = (m_logLevel >= LOG_LVL_DEBUG ? LOG_TARGET_STDOUT : 0) | (logfile && m_logFileLevel >= LOG_LVL_DEBUG ? LOG_TARGET_LOGFILE : 0);
+    if (!targets)
+        return;
 
-    fflush(stderr);
+    va_list ap;
+    va_start(ap, str);
+    SubmitFormatted(targets, LogDebug, 0, "", str, ap);
+    va_end(ap);
 }
 
-void Log::outErrorEventAI()
+void Log::outCommand(uint32 account, const char* str, ...)
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
+    if (!str)
+        return;
 
-    if (m_includeTime)
-        outTime();
+    uint32 targets = (m_logLevel >= LOG_LVL_DETAIL ? LOG_TARGET_STDOUT : 0) | (logfile && m_logFileLevel >= LOG_LVL_DETAIL ? LOG_TARGET_LOGFILE : 0);
+    if (m_gmlog_per_account ? !m_gmlog_filename_format.empty() : gmLogfile != nullptr)
+        targets |= LOG_TARGET_GMLOG;
+    if (!targets)
+        return;
 
-    fprintf(stderr, "\n");
+    va_list ap;
+    va_start(ap, str);
+    SubmitFormatted(targets, LogDetails, account, "", str, ap);
+    va_end(ap);
+}
 
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR CreatureEventAI\n");
-        fflush(logfile);
-    }
+void Log::outChar(const char* str, ...)
+{
+    if (!str || !charLogfile)
+        return;
 
-    if (eventAiErLogfile)
-    {
-        outTimestamp(eventAiErLogfile);
-        fprintf(eventAiErLogfile, "\n");
-        fflush(eventAiErLogfile);
-    }
+    va_list ap;
+    va_start(ap, str);
+    SubmitFormatted(LOG_TARGET_CHARLOG, -1, 0, "", str, ap);
+    va_end(ap);
+}
 
-    fflush(stderr);
+void Log::outErrorScriptLib()
+{
+    std::string prefix = m_scriptLibName ? std::string("<") + m_scriptLibName + " ERROR:> " : "<Scripting Library ERROR>: ";
+    Submit(LOG_TARGET_STDERR | (logfile ? LOG_TARGET_LOGFILE : 0) | (scriptErrLogFile ? LOG_TARGET_SCRIPTERRLOG : 0), -1, 0, 0, prefix.c_str(), "", 0);
 }
 
-void Log::outErrorEventAI(const char* err, ...)
+void Log::outErrorScriptLib(const char* err, ...)
 {
     if (!err)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_colored)
-        SetColor(false, m_colors[LogError]);
-
-    if (m_includeTime)
-        outTime();
+    std::string prefix = m_scriptLibName ? std::string("<") + m_scriptLibName + " ERROR>: " : "<Scripting Library ERROR>: ";
 
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    SubmitFormatted(LOG_TARGET_STDERR | (logfile ? LOG_TARGET_LOGFILE : 0) | (scriptErrLogFile ? LOG_TARGET_SCRIPTERRLOG : 0), LogError, 0, prefix.c_str(), err, ap);
     va_end(ap);
+}
 
-    if (m_colored)
-        ResetColor(false);
-
-    fprintf(stderr, "\n");
-
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR CreatureEventAI: ");
-
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
+void Log::outWorldPacketDump(const char* socket, uint32 opcode, char const* opcodeName, ByteBuffer const& packet, bool incoming)
+{
+    if (!worldLogfile)
+        return;
 
-    if (eventAiErLogfile)
-    {
-        outTimestamp(eventAiErLogfile);
+    // only the header is formatted here, the hex dump is done by the writer
+    char header[512];
+    int length = snprintf(header, sizeof(header), "\n%s:\nSOCKET: %s\nLENGTH: %u\nOPCODE: %s (0x%.4X)\nDATA:\n",
+                          incoming ? "CLIENT" : "SERVER",
+                          socket, static_cast<uint32>(packet.size()), opcodeName, opcode);
+    length = std::min(std::max(length, 0), int(sizeof(header) - 1));
 
-        va_list ap;
-        va_start(ap, err);
-        vfprintf(eventAiErLogfile, err, ap);
-        va_end(ap);
+    Submit(LOG_TARGET_WORLDLOG, -1, LOG_MESSAGE_PACKET, 0, "", header, length, packet.contents(), packet.size());
+}
 
-        fprintf(eventAiErLogfile, "\n");
-        fflush(eventAiErLogfile);
-    }
+void Log::outCharDump(const char* str, uint32 account_id, uint32 guid, const char* name)
+{
+    if (!charLogfile)
+        return;
 
-    fflush(stderr);
+    std::string dump = "== START DUMP == (account: " + std::to_string(account_id) + " guid: " + std::to_string(guid) + " name: " + name + " )\n" + str + "\n== END DUMP ==";
+    Submit(LOG_TARGET_CHARLOG, -1, LOG_MESSAGE_NO_TIMESTAMP, 0, "", dump.c_str(), dump.size());
 }
 
-void Log::outBasic(const char* str, ...)
+void Log::outRALog(const char* str, ...)
 {
-    if (!str)
+    if (!str || !raLogfile)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_logLevel >= LOG_LVL_BASIC)
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LogDetails]);
+    va_list ap;
+    va_start(ap, str);
+    SubmitFormatted(LOG_TARGET_RALOG, -1, 0, "", str, ap);
+    va_end(ap);
+}
 
-        if (m_includeTime)
-            outTime();
+void Log::outCustomLog(const char* str, ...)
+{
+    if (!str || !customLogFile)
+        return;
 
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+    va_list ap;
+    va_start(ap, str);
+    SubmitFormatted(LOG_TARGET_CUSTOMLOG, -1, 0, "", str, ap);
+    va_end(ap);
+}
 
-        if (m_colored)
-            ResetColor(true);
+void Log::SubmitFormatted(uint32 targets, int32 color, uint32 account, char const* prefix, char const* format, va_list ap)
+{
+    // formatting stays in the calling thread, arguments may not outlive the call
+    static thread_local std::vector<char> buffer(1024);
 
-        printf("\n");
-    }
+    va_list copy;
+    va_copy(copy, ap);
+    int length = vsnprintf(buffer.data(), buffer.size(), format, copy);
+    va_end(copy);
 
-    if (logfile && m_logFileLevel >= LOG_LVL_BASIC)
+    if (length < 0)
+        length = 0;
+    else if (size_t(length) >= buffer.size())
     {
-        va_list ap;
-        outTimestamp(logfile);
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
-        va_end(ap);
-        fflush(logfile);
+        buffer.resize(length + 1);
+        vsnprintf(buffer.data(), buffer.size(), format, ap);
     }
 
-    fflush(stdout);
+    Submit(targets, color, 0, account, prefix, buffer.data(), length);
 }
 
-void Log::outDetail(const char* str, ...)
+void Log::Submit(uint32 targets, int32 color, uint32 flags, uint32 account, char const* prefix, char const* text, uint32 textLength, uint8 const* data, uint32 dataLength)
 {
-    if (!str)
-        return;
+    uint32 prefixLength = strlen(prefix);
+    uint32 size = LogMessage::RecordSize(prefixLength, textLength, dataLength);
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_logLevel >= LOG_LVL_DETAIL)
+    auto fill = [&](char* dest)
     {
-        if (m_colored)
-            SetColor(true, m_colors[LogDetails]);
-
-        if (m_includeTime)
-            outTime();
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
-
-        if (m_colored)
-            ResetColor(true);
-
-        printf("\n");
-    }
+        LogMessage* message = reinterpret_cast<LogMessage*>(dest);
+        message->size = size;
+        message->flags = flags;
+        message->sequence = 0;
+        message->time = time(nullptr);
+        message->targets = targets;
+        message->color = color;
+        message->account = account;
+        message->prefixLength = prefixLength;
+        message->textLength = textLength;
+        message->dataLength = dataLength;
+
+        char* out = dest + sizeof(LogMessage);
+        memcpy(out, prefix, prefixLength);
+        out[prefixLength] = '\0';
+        out += prefixLength + 1;
+        memcpy(out, text, textLength);
+        out[textLength] = '\0';
+        out += textLength + 1;
+        if (dataLength)
+            memcpy(out, data, dataLength);
+        return message;
+    };
 
-    if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
     {
-        outTimestamp(logfile);
-
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        va_end(ap);
+        // StopAsync waits for all producers that saw the writer running before the writer's last drain
+        struct ProducerScope
+        {
+            explicit ProducerScope(std::atomic<uint32>& producers) : m_producers(producers) { m_producers.fetch_add(1); }
+            ~ProducerScope() { m_producers.fetch_sub(1); }
+            std::atomic<uint32>& m_producers;
+        } producerScope(m_asyncProducers);
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
+        if (m_asyncRunning.load())
+        {
+            LogRingBuffer* buffer = GetLocalBuffer();
+            // messages too big for the ring (character dumps, huge packets) are written directly
+            if (size <= buffer->GetCapacity() / 2)
+            {
+                char* dest;
+                while (!(dest = buffer->Reserve(size)))
+                {
+                    if (!m_asyncBlock)
+                    {
+                        m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+
+                    // writer is stopping, don't wait for space it may never make
+                    if (!m_asyncRunning.load(std::memory_order_relaxed))
+                        break;
+
+                    m_writerCondition.notify_one();
+                    std::this_thread::yield();
+                }
+
+                if (dest)
+                {
+                    fill(dest)->sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+                    buffer->Commit(size);
+
+                    if (buffer->IsHalfFull())
+                        m_writerCondition.notify_one();
+                    return;
+                }
+            }
+        }
     }
 
-    fflush(stdout);
+    static thread_local std::vector<uint64> scratch;
+    scratch.resize(size / sizeof(uint64));
+    LogMessage const* message = fill(reinterpret_cast<char*>(scratch.data()));
+
+    std::lock_guard<std::mutex> guard(m_worldLogMtx);
+    Write(*message, true);
 }
 
-void Log::outDebug(const char* str, ...)
+void Log::Write(LogMessage const& message, bool flush)
 {
-    if (!str)
-        return;
+    uint32 targets = message.targets;
+    char const* text = message.Text();
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_logLevel >= LOG_LVL_DEBUG)
+    if (targets & (LOG_TARGET_STDOUT | LOG_TARGET_STDERR))
     {
-        if (m_colored)
-            SetColor(true, m_colors[LogDebug]);
+        bool stdout_stream = (targets & LOG_TARGET_STDOUT) != 0;
+        FILE* out = stdout_stream ? stdout : stderr;
+
+        if (m_colored && message.color >= 0)
+            SetColor(stdout_stream, m_colors[message.color]);
 
         if (m_includeTime)
-            outTime();
+            outTime(message.time);
 
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+        utf8printf(out, "%s", text);
 
-        if (m_colored)
-            ResetColor(true);
+        if (m_colored && message.color >= 0)
+            ResetColor(stdout_stream);
 
-        printf("\n");
+        fprintf(out, "\n");
     }
 
-    if (logfile && m_logFileLevel >= LOG_LVL_DEBUG)
+    if ((targets & LOG_TARGET_LOGFILE) && logfile)
     {
-        outTimestamp(logfile);
-
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
+        outTimestamp(logfile, message.time);
+        fprintf(logfile, "%s%s\n", message.Prefix(), text);
     }
 
-    fflush(stdout);
-}
-
-void Log::outCommand(uint32 account, const char* str, ...)
-{
-    if (!str)
-        return;
-
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_logLevel >= LOG_LVL_DETAIL)
+    if (targets & LOG_TARGET_GMLOG)
     {
-        if (m_colored)
-            SetColor(true, m_colors[LogDetails]);
-
-        if (m_includeTime)
-            outTime();
+        if (m_gmlog_per_account)
+        {
+            if (FILE* per_file = openGmlogPerAccount(message.account))
+            {
+                outTimestamp(per_file, message.time);
+                fprintf(per_file, "%s\n", text);
+                fclose(per_file);
+            }
+        }
+        else if (gmLogfile)
+        {
+            outTimestamp(gmLogfile, message.time);
+            fprintf(gmLogfile, "%s\n", text);
+        }
+    }
 
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+    std::pair<uint32, FILE*> const files[] =
+    {
+        { LOG_TARGET_CHARLOG, charLogfile },
+        { LOG_TARGET_DBERRLOG, dberLogfile },
+        { LOG_TARGET_EVENTAIERRLOG, eventAiErLogfile },
+        { LOG_TARGET_SCRIPTERRLOG, scriptErrLogFile },
+        { LOG_TARGET_RALOG, raLogfile },
+        { LOG_TARGET_CUSTOMLOG, customLogFile },
+    };
 
-        if (m_colored)
-            ResetColor(true);
+    for (auto const& file : files)
+    {
+        if (!(targets & file.first) || !file.second)
+            continue;
 
-        printf("\n");
+        if (!(message.flags & LOG_MESSAGE_NO_TIMESTAMP))
+            outTimestamp(file.second, message.time);
+        fprintf(file.second, "%s\n", text);
     }
 
-    if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
+    if ((targets & LOG_TARGET_WORLDLOG) && worldLogfile)
     {
-        va_list ap;
-        outTimestamp(logfile);
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
-        va_end(ap);
-        fflush(logfile);
-    }
+        outTimestamp(worldLogfile, message.time);
+        fputs(text, worldLogfile);
 
-    if (m_gmlog_per_account)
-    {
-        if (FILE* per_file = openGmlogPerAccount(account))
+        if (message.flags & LOG_MESSAGE_PACKET)
         {
-            va_list ap;
-            outTimestamp(per_file);
-            va_start(ap, str);
-            vfprintf(per_file, str, ap);
-            fprintf(per_file, "\n");
-            va_end(ap);
-            fclose(per_file);
+            static char const hex[] = "0123456789ABCDEF";
+            uint8 const* data = message.Data();
+            char line[16 * 3 + 2];
+            for (uint32 p = 0; p < message.dataLength;)
+            {
+                char* out = line;
+                for (uint32 j = 0; j < 16 && p < message.dataLength; ++j, ++p)
+                {
+                    *out++ = hex[data[p] >> 4];
+                    *out++ = hex[data[p] & 0x0F];
+                    *out++ = ' ';
+                }
+                *out++ = '\n';
+                fwrite(line, 1, out - line, worldLogfile);
+            }
+
+            fprintf(worldLogfile, "\n\n");
         }
     }
-    else if (gmLogfile)
-    {
-        va_list ap;
-        outTimestamp(gmLogfile);
-        va_start(ap, str);
-        vfprintf(gmLogfile, str, ap);
-        fprintf(gmLogfile, "\n");
-        va_end(ap);
-        fflush(gmLogfile);
-    }
 
-    fflush(stdout);
+    if (flush)
+        FlushTargets(targets);
 }
 
-void Log::outChar(const char* str, ...)
+void Log::FlushTargets(uint32 targets)
 {
-    if (!str)
-        return;
-
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (charLogfile)
+    std::pair<uint32, FILE*> const files[] =
     {
-        va_list ap;
-        outTimestamp(charLogfile);
-        va_start(ap, str);
-        vfprintf(charLogfile, str, ap);
-        fprintf(charLogfile, "\n");
-        va_end(ap);
-        fflush(charLogfile);
-    }
+        { LOG_TARGET_STDOUT, stdout },
+        { LOG_TARGET_STDERR, stderr },
+        { LOG_TARGET_LOGFILE, logfile },
+        { LOG_TARGET_GMLOG, gmLogfile },
+        { LOG_TARGET_CHARLOG, charLogfile },
+        { LOG_TARGET_DBERRLOG, dberLogfile },
+        { LOG_TARGET_EVENTAIERRLOG, eventAiErLogfile },
+        { LOG_TARGET_SCRIPTERRLOG, scriptErrLogFile },
+        { LOG_TARGET_RALOG, raLogfile },
+        { LOG_TARGET_WORLDLOG, worldLogfile },
+        { LOG_TARGET_CUSTOMLOG, customLogFile },
+    };
+
+    for (auto const& file : files)
+        if ((targets & file.first) && file.second)
+            fflush(file.second);
 }
 
-void Log::outErrorScriptLib()
+namespace
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_includeTime)
-        outTime();
-
-    fprintf(stderr, "\n");
-
-    if (logfile)
+    // Hands the thread buffer back to the writer when the thread exits
+    struct LogBufferHolder
     {
-        outTimestamp(logfile);
-        if (m_scriptLibName)
-            fprintf(logfile, "<%s ERROR:> ", m_scriptLibName);
-        else
-            fprintf(logfile, "<Scripting Library ERROR>: ");
-        fflush(logfile);
-    }
+        ~LogBufferHolder()
+        {
+            if (buffer)
+                buffer->Abandon();
+        }
 
-    if (scriptErrLogFile)
+        LogRingBuffer* buffer = nullptr;
+    };
+}
+
+LogRingBuffer* Log::GetLocalBuffer()
+{
+    static thread_local LogBufferHolder holder;
+    if (!holder.buffer)
     {
-        outTimestamp(scriptErrLogFile);
-        fprintf(scriptErrLogFile, "\n");
-        fflush(scriptErrLogFile);
+        std::lock_guard<std::mutex> guard(m_buffersMtx);
+        m_buffers.emplace_back(new LogRingBuffer(m_asyncBufferSize));
+        holder.buffer = m_buffers.back().get();
     }
-
-    fflush(stderr);
+    return holder.buffer;
 }
 
-void Log::outErrorScriptLib(const char* err, ...)
+void Log::StartAsync()
 {
-    if (!err)
+    if (!m_async || m_asyncRunning)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_colored)
-        SetColor(false, m_colors[LogError]);
-
-    if (m_includeTime)
-        outTime();
-
-    va_list ap;
-
-    va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
-    va_end(ap);
+    m_writerStop = false;
+    m_writerThread = std::thread(&Log::WriterThread, this);
+    m_asyncRunning.store(true, std::memory_order_release);
+}
 
-    if (m_colored)
-        ResetColor(false);
+void Log::StopAsync()
+{
+    if (!m_asyncRunning)
+        return;
 
-    fprintf(stderr, "\n");
+    // new messages are written directly from here on, the writer empties the buffers before it exits
+    m_asyncRunning.store(false);
 
-    if (logfile)
+    // a producer that saw the writer running may still be committing, its message must make the last drain
+    while (m_asyncProducers.load())
     {
-        outTimestamp(logfile);
-        if (m_scriptLibName)
-            fprintf(logfile, "<%s ERROR>: ", m_scriptLibName);
-        else
-            fprintf(logfile, "<Scripting Library ERROR>: ");
-
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
+        m_writerCondition.notify_one();
+        std::this_thread::yield();
     }
 
-    if (scriptErrLogFile)
     {
-        outTimestamp(scriptErrLogFile);
-
-        va_list ap;
-        va_start(ap, err);
-        vfprintf(scriptErrLogFile, err, ap);
-        va_end(ap);
-
-        fprintf(scriptErrLogFile, "\n");
-        fflush(scriptErrLogFile);
+        std::lock_guard<std::mutex> guard(m_buffersMtx);
+        m_writerStop = true;
     }
-
-    fflush(stderr);
+    m_writerCondition.notify_one();
+    m_writerThread.join();
 }
 
-void Log::outWorldPacketDump(const char* socket, uint32 opcode, char const* opcodeName, ByteBuffer const& packet, bool incoming)
+void Log::WriterThread()
 {
-    if (!worldLogfile)
-        return;
-
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-
-    outTimestamp(worldLogfile);
-
-    fprintf(worldLogfile, "\n%s:\nSOCKET: %s\nLENGTH: %u\nOPCODE: %s (0x%.4X)\nDATA:\n",
-            incoming ? "CLIENT" : "SERVER",
-            socket, static_cast<uint32>(packet.size()), opcodeName, opcode);
+    std::vector<LogRingBuffer*> buffers;
+    std::vector<uint64> batch;
+    std::vector<std::pair<uint64, size_t>> order;           // sequence, offset in batch
 
-    size_t p = 0;
-    while (p < packet.size())
+    for (bool stop = false; !stop;)
     {
-        for (size_t j = 0; j < 16 && p < packet.size(); ++j)
-            fprintf(worldLogfile, "%.2X ", packet[p++]);
-
-        fprintf(worldLogfile, "\n");
-    }
+        {
+            std::unique_lock<std::mutex> lock(m_buffersMtx);
+            if (!m_writerStop)
+                m_writerCondition.wait_for(lock, std::chrono::milliseconds(LOG_WRITER_INTERVAL));
+            stop = m_writerStop;
 
-    fprintf(worldLogfile, "\n\n");
-    fflush(worldLogfile);
-}
+            // buffers of exited threads are released once emptied
+            m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(), [](std::unique_ptr<LogRingBuffer> const& buffer)
+            {
+                return buffer->IsAbandoned() && buffer->IsEmpty();
+            }), m_buffers.end());
 
-void Log::outCharDump(const char* str, uint32 account_id, uint32 guid, const char* name)
-{
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
+            buffers.clear();
+            for (auto const& buffer : m_buffers)
+                buffers.push_back(buffer.get());
+        }
 
-    if (charLogfile)
-    {
-        fprintf(charLogfile, "== START DUMP == (account: %u guid: %u name: %s )\n%s\n== END DUMP ==\n", account_id, guid, name, str);
-        fflush(charLogfile);
-    }
-}
+        batch.clear();
+        order.clear();
+        for (LogRingBuffer* buffer : buffers)
+        {
+            buffer->Drain([&](LogMessage const& message)
+            {
+                size_t offset = batch.size();
+                batch.resize(offset + message.size / sizeof(uint64));
+                memcpy(&batch[offset], &message, message.size);
+                order.emplace_back(message.sequence, offset);
+            });
+        }
 
-void Log::outRALog(const char* str, ...)
-{
-    if (!str)
-        return;
+        uint32 dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        if (order.empty() && !dropped)
+            continue;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (raLogfile)
-    {
-        va_list ap;
-        outTimestamp(raLogfile);
-        va_start(ap, str);
-        vfprintf(raLogfile, str, ap);
-        fprintf(raLogfile, "\n");
-        va_end(ap);
-        fflush(raLogfile);
-    }
+        std::sort(order.begin(), order.end());
 
-    fflush(stdout);
-}
+        uint32 targets = 0;
+        std::lock_guard<std::mutex> guard(m_worldLogMtx);
+        for (auto const& entry : order)
+        {
+            LogMessage const& message = *reinterpret_cast<LogMessage const*>(&batch[entry.second]);
+            Write(message, false);
+            targets |= message.targets;
+        }
 
-void Log::outCustomLog(const char* str, ...)
-{
-    if (!str)
-        return;
+        if (dropped)
+        {
+            fprintf(stderr, "Log buffer full, %u messages dropped\n", dropped);
+            if (logfile)
+            {
+                outTimestamp(logfile);
+                fprintf(logfile, "ERROR:Log buffer full, %u messages dropped\n", dropped);
+            }
+            targets |= LOG_TARGET_STDERR | LOG_TARGET_LOGFILE;
+        }
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (customLogFile)
-    {
-        va_list ap;
-        outTimestamp(customLogFile);
-        va_start(ap, str);
-        vfprintf(customLogFile, str, ap);
-        fprintf(customLogFile, "\n");
-        va_end(ap);
-        fflush(customLogFile);
+        FlushTargets(targets);
     }
-
-    fflush(stdout);
 }
 
 void Log::WaitBeforeContinueIfNeed()
@@ -998,6 +1108,8 @@ void Log::WaitBeforeContinueIfNeed()
 
 void Log::setScriptLibraryErrorFile(char const* fname, char const* libName)
 {
+    std::lock_guard<std::mutex> guard(m_worldLogMtx);
+
     m_scriptLibName = libName;
 
     if (scriptErrLogFile)
@@ -1110,14 +1222,11 @@ void script_error_log(const char* str, ...)
 
 void Log::traceLog()
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (customLogFile)
-    {
-        fprintf(customLogFile, "%s\n", GetTraceLog().data());
-        fflush(customLogFile);
-    }
+    if (!customLogFile)
+        return;
 
-    fflush(stdout);
+    std::string trace = GetTraceLog();
+    Submit(LOG_TARGET_CUSTOMLOG, -1, LOG_MESSAGE_NO_TIMESTAMP, 0, "", trace.c_str(), trace.size());
 }
 
 // has to be in a locked enviroment on linux
@@ -22,10 +22,14 @@
 #include "Common.h"
 #include "Policies/Singleton.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 
 class Config;
 class ByteBuffer;
+class LogRingBuffer;
 
 enum LogLevel
 {
@@ -98,44 +102,7 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
         friend class MaNGOS::OperatorNew<Log>;
         Log();
 
-        ~Log()
-        {
-            if (logfile != nullptr)
-                fclose(logfile);
-            logfile = nullptr;
-
-            if (gmLogfile != nullptr)
-                fclose(gmLogfile);
-            gmLogfile = nullptr;
-
-            if (charLogfile != nullptr)
-                fclose(charLogfile);
-            charLogfile = nullptr;
-
-            if (dberLogfile != nullptr)
-                fclose(dberLogfile);
-            dberLogfile = nullptr;
-
-            if (eventAiErLogfile != nullptr)
-                fclose(eventAiErLogfile);
-            eventAiErLogfile = nullptr;
-
-            if (scriptErrLogFile != nullptr)
-                fclose(scriptErrLogFile);
-            scriptErrLogFile = nullptr;
-
-            if (raLogfile != nullptr)
-                fclose(raLogfile);
-            raLogfile = nullptr;
-
-            if (worldLogfile != nullptr)
-                fclose(worldLogfile);
-            worldLogfile = nullptr;
-
-            if (customLogFile != nullptr)
-                fclose(customLogFile);
-            customLogFile = nullptr;
-        }
+        ~Log();
     public:
         void Initialize();
         void InitColors(const std::string& str);
@@ -194,10 +161,28 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
 
         void traceLog();
 
+        // Hand output over to the background writer (if LogAsync is set) / write everything left and return to direct output
+        void StartAsync();
+        void StopAsync();
+
+        struct LogMessage;
+
     private:
         FILE* openLogFile(char const* configFileName, char const* configTimeStampFlag, char const* mode);
         FILE* openGmlogPerAccount(uint32 account);
 
+        void outTime(time_t t) const;
+        static void outTimestamp(FILE* file, time_t t);
+
+        // Every out* call ends here: queued in the calling thread's buffer when async, written under m_worldLogMtx otherwise
+        void Submit(uint32 targets, int32 color, uint32 flags, uint32 account, char const* prefix, char const* text, uint32 textLength, uint8 const* data = nullptr, uint32 dataLength = 0);
+        void SubmitFormatted(uint32 targets, int32 color, uint32 account, char const* prefix, char const* format, va_list ap);
+        void Write(LogMessage const& message, bool flush);
+        void FlushTargets(uint32 targets);
+
+        LogRingBuffer* GetLocalBuffer();
+        void WriterThread();
+
         FILE* raLogfile;
         FILE* logfile;
         FILE* gmLogfile;
@@ -231,6 +216,20 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
         std::string m_gmlog_filename_format;
 
         char const* m_scriptLibName;
+
+        // asynchronous output
+        bool m_async;
+        bool m_asyncBlock;                                  // wait for space instead of dropping when a thread buffer is full
+        uint32 m_asyncBufferSize;
+        std::atomic<bool> m_asyncRunning;
+        std::atomic<uint32> m_asyncProducers;               // threads between the m_asyncRunning check and their commit
+        std::atomic<uint64> m_sequence;                     // keeps the output order across thread buffers
+        std::atomic<uint32> m_dropped;
+        bool m_writerStop;
+        std::thread m_writerThread;
+        std::mutex m_buffersMtx;
+        std::condition_variable m_writerCondition;
+        std::vector<std::unique_ptr<LogRingBuffer>> m_buffers;
 };
 
 #define sLog MaNGOS::Singleton<Log>::Instance()
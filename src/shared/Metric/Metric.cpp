@@ -76,6 +76,8 @@ void metric::measurement::set_condition(std::function<bool()> condition)
 
 metric::metric::metric()
 {
+    // registry has to outlive the write thread which drains it
+    series_registry::instance();
     initialize();
 }
 
@@ -100,13 +102,7 @@ void metric::metric::initialize()
     if (!(m_enabled = sConfig.GetBoolDefault("Metric.Enable", false)))
         return;
 
-    m_connectionInfo = {
-        sConfig.GetStringDefault("Metric.Address", "127.0.0.1"),
-        sConfig.GetIntDefault("Metric.Port", 8086),
-        sConfig.GetStringDefault("Metric.Database", "perfd"),
-        sConfig.GetStringDefault("Metric.Username", ""),
-        sConfig.GetStringDefault("Metric.Password", "")
-    };
+    load_connection_info();
 
     m_sendTimer.reset(new boost::asio::deadline_timer(m_writeService));
     m_queueServiceWork.reset(new boost::asio::io_service::work(m_queueService));
@@ -140,16 +136,26 @@ void metric::metric::reload_config()
 
     m_writeService.post([&]
     {
-        m_connectionInfo = {
-            sConfig.GetStringDefault("Metric.Address", "127.0.0.1"),
-            sConfig.GetIntDefault("Metric.Port", 8086),
-            sConfig.GetStringDefault("Metric.Database", "perfd"),
-            sConfig.GetStringDefault("Metric.Username", ""),
-            sConfig.GetStringDefault("Metric.Password", "")
-        };
+        load_connection_info();
+
+        // reconnect with the new settings on next send
+        m_socket.reset();
+        m_udpSocket.reset();
     });
 }
 
+void metric::metric::load_connection_info()
+{
+    m_connectionInfo = {
+        sConfig.GetStringDefault("Metric.Address", "127.0.0.1"),
+        sConfig.GetIntDefault("Metric.Port", 8086),
+        sConfig.GetStringDefault("Metric.Database", "perfd"),
+        sConfig.GetStringDefault("Metric.Username", ""),
+        sConfig.GetStringDefault("Metric.Password", ""),
+        sConfig.GetBoolDefault("Metric.UDP", false)
+    };
+}
+
 void metric::metric::report(std::string measurement, std::string key, boost::any value, std::map<std::string, std::string> tags)
 {
     report(measurement, { { key, value } }, tags);
@@ -202,8 +208,35 @@ void metric::metric::send()
         std::swap(measurements, m_measurementQueue);
     }
 
+    std::stringstream payload;
+    for (auto const& measurement : measurements)
+    {
+        payload << *measurement;
+        payload << "\n";
+    }
+
+    series_registry::instance().collect(payload);
+
+    std::string data = payload.str();
+    if (data.empty())
+        return;
+
     sLog.outDetail("Sending %zu measurements!", measurements.size());
 
+    if (m_connectionInfo.udp)
+    {
+        send_udp(data);
+        return;
+    }
+
+    // a kept alive connection may have been closed by the server meanwhile, retry once on a fresh one
+    bool reused = m_socket != nullptr;
+    if (!send_http(data) && reused)
+        send_http(data);
+}
+
+bool metric::metric::connect()
+{
     using boost::asio::ip::tcp;
 
     boost::system::error_code error;
@@ -216,34 +249,36 @@ void metric::metric::send()
     if (error)
     {
         sLog.outError("metric::metric::send resolve aborted, %s", error.message().c_str());
-        return;
+        return false;
     }
 
     error = boost::asio::error::host_not_found;
 
     tcp::resolver::iterator end;
 
-    tcp::socket socket(m_writeService);
+    m_socket.reset(new tcp::socket(m_writeService));
     while (error && endpoint_iterator != end)
     {
-        socket.close();
-        socket.connect(*endpoint_iterator++, error);
+        m_socket->close();
+        m_socket->connect(*endpoint_iterator++, error);
     }
 
     if (error)
     {
         sLog.outError("metric::metric::send connect aborted, %s", error.message().c_str());
-        return;
+        m_socket.reset();
+        return false;
     }
 
-    std::stringstream payload;
-    for (auto const& measurement : measurements)
-    {
-        if (&measurement != &measurements.front())
-            payload << "\n";
+    return true;
+}
 
-        payload << *measurement;
-    }
+bool metric::metric::send_http(std::string const& payload)
+{
+    if (!m_socket && !connect())
+        return true;                                        // already reported, no point in retrying
+
+    boost::system::error_code error;
 
     boost::asio::streambuf request;
     std::ostream request_stream(&request);
@@ -251,27 +286,27 @@ void metric::metric::send()
     // Write request
     request_stream << "POST " << "/write?db=" << m_connectionInfo.database << "&u=" << m_connectionInfo.username << "&p=" << m_connectionInfo.password << " HTTP/1.1\r\n";
     request_stream << "Host: " << m_connectionInfo.hostname << "\r\n";
-    request_stream << "Content-Length:" << std::to_string(payload.tellp()) << "\r\n";
-    request_stream << "Connection: close\r\n\r\n";
-    request_stream << payload.rdbuf();
+    request_stream << "Content-Length:" << std::to_string(payload.size()) << "\r\n";
+    request_stream << "Connection: keep-alive\r\n\r\n";
+    request_stream << payload;
 
     // Send the request.
-    boost::asio::write(socket, request, error);
+    boost::asio::write(*m_socket, request, error);
     if (error)
     {
         sLog.outError("metric::metric::send write aborted, %s", error.message().c_str());
-        return;
+        m_socket.reset();
+        return false;
     }
 
-    // Read the response status line. The response streambuf will automatically
-    // grow to accommodate the entire line. The growth may be limited by passing
-    // a maximum size to the streambuf constructor.
+    // Read the status line and headers, the body follows by Content-Length
     boost::asio::streambuf response;
-    boost::asio::read_until(socket, response, "\r\n", error);
+    boost::asio::read_until(*m_socket, response, "\r\n\r\n", error);
     if (error)
     {
         sLog.outError("metric::metric::send read_until aborted, %s", error.message().c_str());
-        return;
+        m_socket.reset();
+        return false;
     }
 
     // Check that response is OK.
@@ -287,37 +322,94 @@ void metric::metric::send()
     if (!response_stream || http_version.substr(0, 5) != "HTTP/")
     {
         sLog.outError("metric::metric::send received invalid response");
-        return;
+        m_socket.reset();
+        return true;
+    }
+
+    size_t contentLength = 0;
+    bool closeConnection = false;
+    std::string header;
+    while (std::getline(response_stream, header) && header != "\r")
+    {
+        std::transform(header.begin(), header.end(), header.begin(), ::tolower);
+        if (header.compare(0, 15, "content-length:") == 0)
+            contentLength = std::stoul(header.substr(15));
+        else if (header.compare(0, 11, "connection:") == 0 && header.find("close") != std::string::npos)
+            closeConnection = true;
+        else if (header.compare(0, 18, "transfer-encoding:") == 0)
+            closeConnection = true;                         // chunked body is not parsed, drop the connection instead
     }
 
+    // Consume the body so the next request starts on a clean stream
+    if (contentLength > response.size())
+        boost::asio::read(*m_socket, response, boost::asio::transfer_exactly(contentLength - response.size()), error);
+
     if (status_code < 200 || status_code >= 300)
     {
         // Should restore measurements back into queue
+        std::string body(std::istreambuf_iterator<char>(response_stream), {});
+        sLog.outError("metric::metric::send response returned with status code %u, %s", status_code, body.c_str());
+    }
 
-        sLog.outError("metric::metric::send response returned with status code %u", status_code);
-
-        // Read the response headers, which are terminated by a blank line.
-        // if this errors out its ok
-        boost::asio::read_until(socket, response, "\r\n\r\n", error);
+    if (error || closeConnection)
+        m_socket.reset();
 
-        // Process the response headers.
-        std::string header;
-        while (std::getline(response_stream, header) && header != "\r")
-            std::cout << header << "\n";
+    return true;
+}
 
-        std::cout << "\n";
+void metric::metric::send_udp(std::string const& payload)
+{
+    using boost::asio::ip::udp;
 
-        // Write whatever content we already have to output.
-        if (response.size() > 0)
-            std::cout << &response;
+    // stay below common MTU, the receiver parses each datagram separately
+    size_t const maxDatagramSize = 1400;
 
-        // Read until EOF, writing data to output as we go.
-        while (boost::asio::read(socket, response, boost::asio::transfer_at_least(1), error))
-            std::cout << &response;
+    boost::system::error_code error;
 
-        if (error != boost::asio::error::eof)
-            throw boost::system::system_error(error);
+    if (!m_udpSocket)
+    {
+        udp::resolver resolver(m_writeService);
+        udp::resolver::query query(m_connectionInfo.hostname, std::to_string(m_connectionInfo.port));
+        udp::resolver::iterator endpoint_iterator = resolver.resolve(query, error);
+
+        if (error || endpoint_iterator == udp::resolver::iterator())
+        {
+            sLog.outError("metric::metric::send resolve aborted, %s", error.message().c_str());
+            return;
+        }
+
+        m_udpEndpoint = *endpoint_iterator;
+        m_udpSocket.reset(new udp::socket(m_writeService));
+        m_udpSocket->open(m_udpEndpoint.protocol(), error);
+        if (error)
+        {
+            sLog.outError("metric::metric::send open aborted, %s", error.message().c_str());
+            m_udpSocket.reset();
+            return;
+        }
+    }
 
-        return;
+    // split on line boundaries, a line longer than a datagram is sent on its own
+    size_t start = 0;
+    while (start < payload.size())
+    {
+        size_t end = payload.size();
+        if (end - start > maxDatagramSize)
+        {
+            end = payload.rfind('\n', start + maxDatagramSize);
+            if (end == std::string::npos || end < start)
+                end = payload.find('\n', start);
+            end = end == std::string::npos ? payload.size() : end + 1;
+        }
+
+        m_udpSocket->send_to(boost::asio::buffer(payload.data() + start, end - start), m_udpEndpoint, 0, error);
+        if (error)
+        {
+            sLog.outError("metric::metric::send send_to aborted, %s", error.message().c_str());
+            m_udpSocket.reset();
+            return;
+        }
+
+        start = end;
     }
 }
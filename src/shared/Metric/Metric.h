@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "Measurement.h"
+#include "Series.h"
 #include "Common.h"
 
 struct MetricConnectionInfo
@@ -38,6 +39,7 @@ struct MetricConnectionInfo
     std::string database;
     std::string username;
     std::string password;
+    bool udp;                                               // line protocol datagrams instead of HTTP requests
 };
 
 namespace metric
@@ -116,6 +118,8 @@ namespace metric
 
             void reload_config();
 
+            bool is_enabled() const { return m_enabled; }
+
             void report(std::string measurement, std::string key, boost::any value, std::map<std::string, std::string> tags = {});
             void report(std::string measurement, std::map<std::string, boost::any> fields, std::map<std::string, std::string> tags = {});
 
@@ -135,9 +139,18 @@ namespace metric
             std::mutex m_queueWriteLock;
             std::vector<std::unique_ptr<Measurement>> m_measurementQueue;
 
+            // kept open between flushes, only used from the write service thread
+            std::unique_ptr<boost::asio::ip::tcp::socket> m_socket;
+            std::unique_ptr<boost::asio::ip::udp::socket> m_udpSocket;
+            boost::asio::ip::udp::endpoint m_udpEndpoint;
+
+            void load_connection_info();
             void schedule_timer();
             void prepare_send(const boost::system::error_code& ec);
             void send();
+            bool connect();
+            bool send_http(std::string const& payload);
+            void send_udp(std::string const& payload);
     };
 }
 
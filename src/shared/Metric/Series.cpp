@@ -0,0 +1,301 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Metric.h"
+#include "Series.h"
+
+metric::thread_cells::thread_cells()
+{
+    for (auto& page : m_pages)
+        page.store(nullptr, std::memory_order_relaxed);
+}
+
+metric::thread_cells::~thread_cells()
+{
+    for (auto& page : m_pages)
+        delete[] page.load(std::memory_order_relaxed);
+}
+
+std::atomic<int64>& metric::thread_cells::cell(uint32 index)
+{
+    // the registry never hands out offsets beyond the pages, keep going with a scratch cell should it happen anyway
+    if (index >= PAGE_SIZE * MAX_PAGES)
+    {
+        static thread_local std::atomic<int64> overflow(0);
+        return overflow;
+    }
+
+    std::atomic<int64>* page = m_pages[index / PAGE_SIZE].load(std::memory_order_acquire);
+    if (!page)
+    {
+        // only the owning thread allocates, readers see either nullptr or a fully zeroed page
+        page = new std::atomic<int64>[PAGE_SIZE];
+        for (uint32 i = 0; i < PAGE_SIZE; ++i)
+            page[i].store(0, std::memory_order_relaxed);
+        m_pages[index / PAGE_SIZE].store(page, std::memory_order_release);
+    }
+
+    return page[index % PAGE_SIZE];
+}
+
+int64 metric::thread_cells::take(uint32 index)
+{
+    std::atomic<int64>* page = m_pages[index / PAGE_SIZE].load(std::memory_order_acquire);
+    return page ? page[index % PAGE_SIZE].exchange(0, std::memory_order_relaxed) : 0;
+}
+
+void metric::thread_cells::move_to(thread_cells& target)
+{
+    for (uint32 p = 0; p < MAX_PAGES; ++p)
+    {
+        std::atomic<int64>* page = m_pages[p].load(std::memory_order_acquire);
+        if (!page)
+            continue;
+
+        for (uint32 i = 0; i < PAGE_SIZE; ++i)
+            if (int64 value = page[i].exchange(0, std::memory_order_relaxed))
+                target.cell(p * PAGE_SIZE + i).fetch_add(value, std::memory_order_relaxed);
+    }
+}
+
+namespace
+{
+    // Registers the thread storage on first use and hands the leftovers back on thread exit
+    struct thread_cells_holder
+    {
+        thread_cells_holder() { metric::series_registry::instance().attach(&cells); }
+        ~thread_cells_holder() { metric::series_registry::instance().detach(&cells); }
+
+        metric::thread_cells cells;
+    };
+}
+
+std::atomic<int64>& metric::detail::local_cell(uint32 index)
+{
+    static thread_local thread_cells_holder holder;
+    return holder.cells.cell(index);
+}
+
+metric::series_registry::series_registry() : m_nextCell(0)
+{
+}
+
+metric::series_registry& metric::series_registry::instance()
+{
+    static series_registry instance;
+    return instance;
+}
+
+metric::series_entry* metric::series_registry::acquire(series_type type, std::string const& name, std::map<std::string, std::string> const& tags)
+{
+    // line protocol prefix, tags are already sorted by std::map
+    std::string key = name;
+    for (auto const& tag : tags)
+        key += "," + tag.first + "=" + tag.second;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto itr = m_entryByKey.find(key);
+    if (itr != m_entryByKey.end())
+    {
+        series_entry& entry = m_entries[itr->second];
+        MANGOS_ASSERT(entry.type == type);
+        ++entry.refs;
+        return &entry;
+    }
+
+    uint32 cells = type == series_type::histogram ? histogram_layout::cells : (type == series_type::counter ? 1 : 0);
+    uint32 offset = m_nextCell;
+    auto& freeCells = m_freeCells[cells];
+    if (!freeCells.empty())
+    {
+        offset = freeCells.back();
+        freeCells.pop_back();
+    }
+    else if (m_nextCell + cells > thread_cells::PAGE_SIZE * thread_cells::MAX_PAGES)
+    {
+        // out of cells, the series is dropped (it stays inactive) instead of taking the server down
+        static bool logged = false;
+        if (!logged)
+        {
+            sLog.outError("Metric: no cells left for series %s, further series without free cells are not reported", key.c_str());
+            logged = true;
+        }
+        return nullptr;
+    }
+    else
+        m_nextCell += cells;
+
+    uint32 index = m_entries.size();
+    if (!m_freeEntries.empty())
+    {
+        index = m_freeEntries.back();
+        m_freeEntries.pop_back();
+    }
+    else
+        m_entries.emplace_back();
+
+    series_entry& entry = m_entries[index];
+    entry.key = std::move(key);
+    entry.type = type;
+    entry.index = index;
+    entry.offset = offset;
+    entry.refs = 1;
+    entry.gauge.store(0, std::memory_order_relaxed);
+
+    m_entryByKey[entry.key] = index;
+    return &entry;
+}
+
+void metric::series_registry::release(series_entry* entry)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if (--entry->refs)
+        return;
+
+    // flush what is left with the next send and leave zeroed cells for the next owner of the slot
+    std::ostringstream out;
+    write_entry(*entry, out, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    m_releasedLines += out.str();
+
+    uint32 cells = entry->type == series_type::histogram ? histogram_layout::cells : (entry->type == series_type::counter ? 1 : 0);
+    if (cells)
+        m_freeCells[cells].push_back(entry->offset);
+
+    m_entryByKey.erase(entry->key);
+    m_freeEntries.push_back(entry->index);
+    entry->key.clear();
+}
+
+void metric::series_registry::attach(thread_cells* cells)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_threads.push_back(cells);
+}
+
+void metric::series_registry::detach(thread_cells* cells)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_threads.erase(std::remove(m_threads.begin(), m_threads.end(), cells), m_threads.end());
+
+    // maxima must not be summed up with the retired values
+    for (auto& entry : m_entries)
+    {
+        if (!entry.refs || entry.type != series_type::histogram)
+            continue;
+
+        std::atomic<int64>& retiredMax = m_retired.cell(entry.offset + histogram_layout::max_cell);
+        retiredMax.store(std::max(retiredMax.load(std::memory_order_relaxed), cells->take(entry.offset + histogram_layout::max_cell)), std::memory_order_relaxed);
+    }
+    cells->move_to(m_retired);
+}
+
+int64 metric::series_registry::take(uint32 index)
+{
+    int64 value = m_retired.take(index);
+    for (thread_cells* cells : m_threads)
+        value += cells->take(index);
+    return value;
+}
+
+int64 metric::series_registry::take_max(uint32 index)
+{
+    int64 value = m_retired.take(index);
+    for (thread_cells* cells : m_threads)
+        value = std::max(value, cells->take(index));
+    return value;
+}
+
+void metric::series_registry::write_entry(series_entry& entry, std::ostream& out, uint64 timestamp)
+{
+    switch (entry.type)
+    {
+        case series_type::counter:
+            out << entry.key << " value=" << take(entry.offset) << "i " << timestamp << "\n";
+            break;
+        case series_type::gauge:
+            out << entry.key << " value=" << entry.gauge.load(std::memory_order_relaxed) << "i " << timestamp << "\n";
+            break;
+        case series_type::histogram:
+        {
+            int64 buckets[histogram_layout::buckets];
+            int64 count = 0;
+            for (uint32 i = 0; i < histogram_layout::buckets; ++i)
+                count += (buckets[i] = take(entry.offset + i));
+
+            int64 sum = take(entry.offset + histogram_layout::sum_cell);
+            int64 max = take_max(entry.offset + histogram_layout::max_cell);
+            if (!count)
+                break;
+
+            // percentiles are reported as the lower bound of their bucket, never above the real maximum
+            double const quantiles[] = { 0.5, 0.9, 0.99 };
+            int64 results[3] = { max, max, max };
+            int64 seen = 0;
+            uint32 q = 0;
+            for (uint32 i = 0; i < histogram_layout::buckets && q < 3; ++i)
+            {
+                seen += buckets[i];
+                while (q < 3 && seen >= int64(std::ceil(quantiles[q] * count)))
+                    results[q++] = std::min(max, int64(histogram_layout::lower_bound(i)));
+            }
+
+            out << entry.key << " count=" << count << "i,sum=" << sum << "i,max=" << max << "i,p50=" << results[0]
+                << "i,p90=" << results[1] << "i,p99=" << results[2] << "i " << timestamp << "\n";
+            break;
+        }
+    }
+}
+
+void metric::series_registry::collect(std::ostream& out)
+{
+    uint64 timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    out << m_releasedLines;
+    m_releasedLines.clear();
+
+    for (auto& entry : m_entries)
+        if (entry.refs)
+            write_entry(entry, out, timestamp);
+}
+
+metric::series::series(series_type type, std::string const& name, std::map<std::string, std::string> const& tags)
+    : m_entry(nullptr), m_offset(0)
+{
+    if (!metric::instance().is_enabled())
+        return;
+
+    m_entry = series_registry::instance().acquire(type, name, tags);
+    if (m_entry)
+        m_offset = m_entry->offset;
+}
+
+metric::series::~series()
+{
+    if (m_entry)
+        series_registry::instance().release(m_entry);
+}
+
+void metric::gauge::set(int64 value)
+{
+    if (m_entry)
+        m_entry->gauge.store(value, std::memory_order_relaxed);
+}
@@ -0,0 +1,238 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOSSERVER_METRIC_SERIES_H
+#define MANGOSSERVER_METRIC_SERIES_H
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+
+// Pre-registered metric series
+//
+// Unlike metric::measurement, which builds its tags and fields on every use, a series is registered once
+// (name and tags are interned into the line protocol prefix) and afterwards only bumps per thread cells.
+// metric::metric aggregates all threads once per flush and sends one line per series.
+
+namespace metric
+{
+    enum class series_type : uint8
+    {
+        counter,
+        gauge,
+        histogram
+    };
+
+    // Log-linear buckets: values below 16 are exact, above that every power of two is split into 8 buckets
+    struct histogram_layout
+    {
+        static constexpr uint32 sub_bits = 3;
+        static constexpr uint32 sub_count = 1 << sub_bits;
+        static constexpr uint32 buckets = (64 - sub_bits + 1) * sub_count;
+        static constexpr uint32 sum_cell = buckets;         // cells following the buckets
+        static constexpr uint32 max_cell = buckets + 1;
+        static constexpr uint32 cells = buckets + 2;
+
+        static uint32 bucket(uint64 value)
+        {
+            if (value < 2 * sub_count)
+                return uint32(value);
+
+            uint32 msb = 0;
+            for (uint32 step = 32; step; step >>= 1)
+            {
+                if (value >> (msb + step))
+                    msb += step;
+            }
+
+            uint32 shift = msb - sub_bits;
+            return (shift + 1) * sub_count + uint32((value >> shift) & (sub_count - 1));
+        }
+
+        static uint64 lower_bound(uint32 bucket)
+        {
+            if (bucket < 2 * sub_count)
+                return bucket;
+
+            uint32 shift = bucket / sub_count - 1;
+            return uint64(sub_count + bucket % sub_count) << shift;
+        }
+    };
+
+    struct series_entry
+    {
+        std::string key;                                    // interned "name,tag=value,..." line protocol prefix
+        series_type type;
+        uint32 index;
+        uint32 offset;
+        uint32 refs;
+        std::atomic<int64> gauge;
+    };
+
+    // Accumulation cells of one thread, written by the owner and drained by the metric flush
+    class thread_cells
+    {
+        public:
+            static constexpr uint32 PAGE_SIZE = 1024;
+            static constexpr uint32 MAX_PAGES = 1024;
+
+            thread_cells();
+            ~thread_cells();
+
+            std::atomic<int64>& cell(uint32 index);
+            int64 take(uint32 index);
+            void move_to(thread_cells& target);
+
+        private:
+            std::atomic<std::atomic<int64>*> m_pages[MAX_PAGES];
+    };
+
+    class series_registry
+    {
+        public:
+            static series_registry& instance();
+
+            // nullptr when the cells of all threads are used up
+            series_entry* acquire(series_type type, std::string const& name, std::map<std::string, std::string> const& tags);
+            void release(series_entry* entry);
+
+            void attach(thread_cells* cells);
+            void detach(thread_cells* cells);
+
+            // Drains all threads and writes one line per live series
+            void collect(std::ostream& out);
+
+        private:
+            series_registry();
+
+            int64 take(uint32 index);
+            int64 take_max(uint32 index);
+            void write_entry(series_entry& entry, std::ostream& out, uint64 timestamp);
+
+            std::mutex m_lock;
+            std::deque<series_entry> m_entries;             // stable addresses, handles keep pointers
+            std::unordered_map<std::string, uint32> m_entryByKey;
+            std::vector<uint32> m_freeEntries;
+            std::map<uint32, std::vector<uint32>> m_freeCells; // cell count -> released offsets
+            uint32 m_nextCell;
+
+            std::vector<thread_cells*> m_threads;
+            thread_cells m_retired;                         // leftovers of exited threads
+            std::string m_releasedLines;                    // last values of released series
+    };
+
+    namespace detail
+    {
+        // Accumulation cell of the calling thread, the thread storage is registered on first use
+        std::atomic<int64>& local_cell(uint32 index);
+    }
+
+    class series
+    {
+        public:
+            series(series_type type, std::string const& name, std::map<std::string, std::string> const& tags);
+            ~series();
+
+            series(series const&) = delete;
+            series& operator=(series const&) = delete;
+
+            bool is_active() const { return m_entry != nullptr; }
+
+        protected:
+            series_entry* m_entry;                          // nullptr when metrics are disabled
+            uint32 m_offset;                                // first cell of this series
+    };
+
+    class counter : public series
+    {
+        public:
+            counter(std::string const& name, std::map<std::string, std::string> const& tags = {})
+                : series(series_type::counter, name, tags)
+            {}
+
+            void add(int64 value = 1)
+            {
+                if (m_entry)
+                    detail::local_cell(m_offset).fetch_add(value, std::memory_order_relaxed);
+            }
+    };
+
+    class gauge : public series
+    {
+        public:
+            gauge(std::string const& name, std::map<std::string, std::string> const& tags = {})
+                : series(series_type::gauge, name, tags)
+            {}
+
+            void set(int64 value);
+    };
+
+    class histogram : public series
+    {
+        public:
+            histogram(std::string const& name, std::map<std::string, std::string> const& tags = {})
+                : series(series_type::histogram, name, tags)
+            {}
+
+            void record(int64 value)
+            {
+                if (!m_entry)
+                    return;
+
+                if (value < 0)
+                    value = 0;
+
+                detail::local_cell(m_offset + histogram_layout::bucket(uint64(value))).fetch_add(1, std::memory_order_relaxed);
+                detail::local_cell(m_offset + histogram_layout::sum_cell).fetch_add(value, std::memory_order_relaxed);
+
+                std::atomic<int64>& max = detail::local_cell(m_offset + histogram_layout::max_cell);
+                int64 current = max.load(std::memory_order_relaxed);
+                while (current < value && !max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+            }
+    };
+
+    // Records the lifetime of the object into a histogram
+    template <class precision>
+    class scoped_timer
+    {
+        public:
+            explicit scoped_timer(histogram& target)
+                : m_target(target), m_startTime(std::chrono::steady_clock::now())
+            {}
+
+            ~scoped_timer()
+            {
+                if (m_target.is_active())
+                    m_target.record(std::chrono::duration_cast<precision>(std::chrono::steady_clock::now() - m_startTime).count());
+            }
+
+        private:
+            histogram& m_target;
+            std::chrono::steady_clock::time_point m_startTime;
+    };
+}
+
+#endif // MANGOSSERVER_METRIC_SERIES_H
@@ -32,13 +32,31 @@ namespace MaNGOS
     class AsyncSocket : public std::enable_shared_from_this<SocketType>
     {
         public:
+            // buffer sequence referring to a caller owned vector, async_write copies its buffer sequence argument
+            struct BufferSequenceRef
+            {
+                typedef boost::asio::const_buffer value_type;
+                typedef std::vector<boost::asio::const_buffer>::const_iterator const_iterator;
+
+                const_iterator begin() const { return buffers->begin(); }
+                const_iterator end() const { return buffers->end(); }
+
+                std::vector<boost::asio::const_buffer> const* buffers;
+            };
+
             AsyncSocket(boost::asio::io_service& io_service);
             virtual ~AsyncSocket();
 
             void Read(char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
+            // completes as soon as any data arrived, with at most length bytes
+            void ReadSome(char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
             void ReadUntil(std::string& buffer, char delimiter, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
             void ReadSkip(size_t skipSize, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
             void Write(const char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
+            // writes all buffers in order with as few system calls as possible, the vector and the memory it points to must outlive the write
+            void Write(std::vector<boost::asio::const_buffer> const& buffers, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
+            // completion handlers of the socket and posted callbacks never run concurrently
+            void Post(std::function<void()>&& callback);
 
             bool Start();
             void Close()
@@ -65,6 +83,7 @@ namespace MaNGOS
             virtual bool OnOpen() = 0;
 
             boost::asio::ip::tcp::socket m_socket;
+            boost::asio::io_service::strand m_strand;
 
             std::mutex m_closeMutex;
             std::string m_address;
@@ -74,7 +93,7 @@ namespace MaNGOS
     };
 
     template <typename SocketType>
-    MaNGOS::AsyncSocket<SocketType>::AsyncSocket(boost::asio::io_service& io_service) : m_socket(io_service), m_address("0.0.0.0"),
+    MaNGOS::AsyncSocket<SocketType>::AsyncSocket(boost::asio::io_service& io_service) : m_socket(io_service), m_strand(io_service), m_address("0.0.0.0"),
         m_remoteAddress(boost::asio::ip::address()), m_remotePort(0)
     {
 
@@ -89,13 +108,19 @@ namespace MaNGOS
     template <typename SocketType>
     void MaNGOS::AsyncSocket<SocketType>::Read(char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
     {
-        boost::asio::async_read(m_socket, boost::asio::buffer(buffer, length), callback);
+        boost::asio::async_read(m_socket, boost::asio::buffer(buffer, length), boost::asio::bind_executor(m_strand, std::move(callback)));
+    }
+
+    template <typename SocketType>
+    void MaNGOS::AsyncSocket<SocketType>::ReadSome(char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
+    {
+        m_socket.async_read_some(boost::asio::buffer(buffer, length), boost::asio::bind_executor(m_strand, std::move(callback)));
     }
 
     template <typename SocketType>
     void MaNGOS::AsyncSocket<SocketType>::ReadUntil(std::string& buffer, char delimiter, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
     {
-        boost::asio::async_read_until(m_socket, boost::asio::dynamic_buffer(buffer, 1024), delimiter, callback);
+        boost::asio::async_read_until(m_socket, boost::asio::dynamic_buffer(buffer, 1024), delimiter, boost::asio::bind_executor(m_strand, std::move(callback)));
     }
 
     template<typename SocketType>
@@ -111,7 +136,19 @@ namespace MaNGOS
     template <typename SocketType>
     void MaNGOS::AsyncSocket<SocketType>::Write(const char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
     {
-        boost::asio::async_write(m_socket, boost::asio::buffer(buffer, length), callback);
+        boost::asio::async_write(m_socket, boost::asio::buffer(buffer, length), boost::asio::bind_executor(m_strand, std::move(callback)));
+    }
+
+    template <typename SocketType>
+    void MaNGOS::AsyncSocket<SocketType>::Write(std::vector<boost::asio::const_buffer> const& buffers, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
+    {
+        boost::asio::async_write(m_socket, BufferSequenceRef{ &buffers }, boost::asio::bind_executor(m_strand, std::move(callback)));
+    }
+
+    template <typename SocketType>
+    void MaNGOS::AsyncSocket<SocketType>::Post(std::function<void()>&& callback)
+    {
+        boost::asio::post(m_strand, std::move(callback));
     }
 
     template <typename SocketType>
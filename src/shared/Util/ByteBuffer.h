@@ -361,8 +361,10 @@ class ByteBuffer
         }
 
         const uint8* contents() const { return &_storage[0]; }
+        uint8* contents() { return &_storage[0]; }
 
         size_t size() const { return _storage.size(); }
+        size_t capacity() const { return _storage.capacity(); }
         bool empty() const { return _storage.empty(); }
 
         void resize(size_t newsize)
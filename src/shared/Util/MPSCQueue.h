@@ -0,0 +1,174 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _MPSCQ_H
+#define _MPSCQ_H
+
+#include "Platform/Define.h"
+
+#include <array>
+#include <atomic>
+
+/**
+ * Lock free queue for any number of producers and a single consumer (intrusive node queue by D. Vyukov).
+ *
+ * Nodes come from a fixed pool of PoolSize entries which is shared through a tagged free list, values
+ * stay constructed in their node so memory they own (buffers) is reused. When the pool is exhausted
+ * nodes are allocated from the heap and freed once consumed.
+ */
+template <typename T, uint32 PoolSize = 64>
+class MPSCQueue
+{
+    private:
+        struct Node
+        {
+            Node() : next(nullptr), nextFree(NO_NODE), pooled(false) {}
+
+            std::atomic<Node*> next;
+            std::atomic<uint32> nextFree;
+            bool pooled;
+            T value;
+        };
+
+        static constexpr uint32 NO_NODE = 0xFFFFFFFF;
+
+    public:
+        MPSCQueue() : m_head(&m_stub), m_tail(&m_stub), m_free(0)
+        {
+            for (uint32 i = 0; i < PoolSize; ++i)
+            {
+                m_pool[i].pooled = true;
+                m_pool[i].nextFree = i + 1 < PoolSize ? i + 1 : NO_NODE;
+            }
+        }
+        MPSCQueue(const MPSCQueue&) = delete;
+
+        ~MPSCQueue()
+        {
+            ConsumeAll([](T&) {});
+        }
+
+        // any thread - fill receives the node value, which may hold data of a previous use
+        template <typename Fill>
+        void Push(Fill&& fill)
+        {
+            Node* node = Acquire();
+            fill(node->value);
+            Link(node);
+        }
+
+        // consumer thread only - returns the number of consumed values
+        // values pushed while their producer is still linking them in are left for the next call
+        template <typename Consume>
+        uint32 ConsumeAll(Consume&& consume)
+        {
+            uint32 count = 0;
+            while (Node* node = Pop())
+            {
+                consume(node->value);
+                Release(node);
+                ++count;
+            }
+            return count;
+        }
+
+    private:
+        void Link(Node* node)
+        {
+            node->next.store(nullptr, std::memory_order_relaxed);
+            Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        Node* Pop()
+        {
+            Node* tail = m_tail;
+            Node* next = tail->next.load(std::memory_order_acquire);
+            if (tail == &m_stub)
+            {
+                if (!next)
+                    return nullptr;
+                m_tail = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+
+            if (next)
+            {
+                m_tail = next;
+                return tail;
+            }
+
+            if (tail != m_head.load(std::memory_order_acquire))
+                return nullptr;
+
+            Link(&m_stub);
+
+            next = tail->next.load(std::memory_order_acquire);
+            if (next)
+            {
+                m_tail = next;
+                return tail;
+            }
+            return nullptr;
+        }
+
+        Node* Acquire()
+        {
+            uint64 head = m_free.load(std::memory_order_acquire);
+            while (true)
+            {
+                uint32 index = uint32(head);
+                if (index == NO_NODE)
+                    return new Node();
+
+                // the tag in the upper half protects against the entry being taken and returned meanwhile
+                uint64 newHead = (((head >> 32) + 1) << 32) | m_pool[index].nextFree.load(std::memory_order_relaxed);
+                if (m_free.compare_exchange_weak(head, newHead, std::memory_order_acq_rel))
+                    return &m_pool[index];
+            }
+        }
+
+        void Release(Node* node)
+        {
+            if (!node->pooled)
+            {
+                delete node;
+                return;
+            }
+
+            uint32 index = uint32(node - m_pool.data());
+            uint64 head = m_free.load(std::memory_order_relaxed);
+            while (true)
+            {
+                node->nextFree.store(uint32(head), std::memory_order_relaxed);
+                uint64 newHead = (((head >> 32) + 1) << 32) | index;
+                if (m_free.compare_exchange_weak(head, newHead, std::memory_order_acq_rel))
+                    return;
+            }
+        }
+
+        std::atomic<Node*> m_head;                          // producers
+        Node* m_tail;                                       // consumer
+        Node m_stub;
+
+        std::array<Node, PoolSize> m_pool;
+        std::atomic<uint64> m_free;                         // tag << 32 | first free pool index
+};
+
+#endif
@@ -31,6 +31,7 @@ class BarGoLink
         void step();
 
         static void SetOutputState(bool on);
+        static bool GetOutputState() { return m_showOutput; }
     private:
         void init(size_t row_count);
 